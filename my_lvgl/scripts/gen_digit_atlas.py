@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0
+"""
+从 LVGL 自带的 lv_font_*.c 里取出数字/分隔符字形，按给定前景/背景色预先混合成
+不透明 RGB565 精灵，生成一个 C 源文件（图集）。运行时直接按图片拷贝，不再走字体引擎
+（查字形、解压、抗锯齿混合）。
+
+- 数字按最宽的数字定宽（等宽排版），数字变化时精灵尺寸不变；--tabular 指定哪些字符按这个宽度居中
+- 精灵高度 = 字体行高，整块不透明，控件背景须与 --bg 一致
+- 默认按 CPU 字节序输出（LVGL 绘制缓冲是本机序，CONFIG_LV_COLOR_16_SWAP 在 flush 时统一交换）；
+  --swap 输出面板字节序，供绕过 LVGL 直接 display_write 的场合使用
+
+用法：
+  gen_digit_atlas.py --font lv_font_montserrat_18.c --name clock \\
+                     --fg 212121 --bg 2196F3 -o ui_atlas_clock.c
+"""
+
+import argparse
+import re
+import sys
+
+DEFAULT_CHARS = "0123456789:-/ "
+DEFAULT_TABULAR = "0123456789 "
+
+
+# ---------------------------------------------------------------- 解析字体源文件
+def parse_font(path):
+    with open(path, encoding="utf-8") as f:
+        src = f.read()
+
+    def c_array(name):
+        m = re.search(r"\b" + name + r"\[\]\s*=\s*\{(.*?)\n\};", src, re.S)
+        if not m:
+            sys.exit(f"{path}: cannot find {name}[]")
+        return re.sub(r"/\*.*?\*/", "", m.group(1), flags=re.S)
+
+    def scalar(field, default=None):
+        m = re.search(r"\." + field + r"\s*=\s*(-?\d+)", src)
+        if m:
+            return int(m.group(1))
+        if default is None:
+            sys.exit(f"{path}: cannot find .{field}")
+        return default
+
+    bitmap = [int(x, 0) for x in re.findall(r"0x[0-9a-fA-F]+|\b\d+\b", c_array("glyph_bitmap"))]
+
+    glyphs = []
+    for g in re.finditer(r"\{([^{}]*\.bitmap_index[^{}]*)\}", c_array("glyph_dsc")):
+        d = dict((k, int(v)) for k, v in re.findall(r"\.(\w+)\s*=\s*(-?\d+)", g.group(1)))
+        glyphs.append(d)
+
+    # 只支持首个 FORMAT0_TINY 区间（LVGL 内置字体的 ASCII 段就是这样）
+    cm = re.search(r"\.range_start\s*=\s*(\d+),\s*\.range_length\s*=\s*(\d+),"
+                   r"\s*\.glyph_id_start\s*=\s*(\d+)", c_array("cmaps"))
+    if not cm:
+        sys.exit(f"{path}: cannot parse cmaps[]")
+
+    return {
+        "bitmap": bitmap,
+        "glyphs": glyphs,
+        "range": tuple(int(x) for x in cm.groups()),
+        "bpp": scalar("bpp"),
+        "format": scalar("bitmap_format", 0),
+        "line_height": scalar("line_height"),
+        "base_line": scalar("base_line"),
+    }
+
+
+# ---------------------------------------------------------------- 位图解码
+def get_bits(data, pos, n):
+    """与 lv_font_fmt_txt.c 的 get_bits() 相同：MSB 在前"""
+    byte, bit = pos >> 3, pos & 7
+    v = (data[byte] << 8) | (data[byte + 1] if byte + 1 < len(data) else 0)
+    return (v >> (16 - bit - n)) & ((1 << n) - 1)
+
+
+class Rle:
+    """lv_font_fmt_txt.c 的 rle_next() 状态机"""
+    SINGLE, REPEATED, COUNTER = range(3)
+
+    def __init__(self, data, bpp):
+        self.d, self.bpp = data, bpp
+        self.rdp, self.prev, self.cnt, self.state = 0, 0, 0, Rle.SINGLE
+
+    def _literal(self):
+        v = get_bits(self.d, self.rdp, self.bpp)
+        self.rdp += self.bpp
+        self.prev = v
+        self.state = Rle.SINGLE
+        return v
+
+    def next(self):
+        if self.state == Rle.SINGLE:
+            v = get_bits(self.d, self.rdp, self.bpp)
+            if self.rdp != 0 and self.prev == v:
+                self.cnt = 0
+                self.state = Rle.REPEATED
+            self.prev = v
+            self.rdp += self.bpp
+            return v
+
+        if self.state == Rle.REPEATED:
+            bit = get_bits(self.d, self.rdp, 1)
+            self.cnt += 1
+            self.rdp += 1
+            if bit == 0:
+                return self._literal()
+            if self.cnt == 11:
+                self.cnt = get_bits(self.d, self.rdp, 6)
+                self.rdp += 6
+                if self.cnt != 0:
+                    self.state = Rle.COUNTER
+                else:
+                    return self._literal()
+            return self.prev
+
+        self.cnt -= 1
+        if self.cnt == 0:
+            return self._literal()
+        return self.prev
+
+
+def glyph_alpha(font, g):
+    """返回 box_h 行、每行 box_w 个 0..255 覆盖度"""
+    w, h, bpp = g["box_w"], g["box_h"], font["bpp"]
+    if w == 0 or h == 0:
+        return []
+
+    data = font["bitmap"][g["bitmap_index"]:]
+    fmt = font["format"]
+    if fmt == 0:
+        vals = [get_bits(data, i * bpp, bpp) for i in range(w * h)]
+        rows = [vals[y * w:(y + 1) * w] for y in range(h)]
+    elif fmt in (1, 2):
+        rle = Rle(data, bpp)
+        rows, prev = [], None
+        for _ in range(h):
+            line = [rle.next() for _ in range(w)]
+            if fmt == 1 and prev is not None:      # 行间 XOR 预滤波
+                line = [a ^ b for a, b in zip(line, prev)]
+            rows.append(line)
+            prev = line
+    else:
+        sys.exit(f"unsupported bitmap_format {fmt}")
+
+    scale = 255 // ((1 << bpp) - 1)
+    return [[v * scale for v in r] for r in rows]
+
+
+# ---------------------------------------------------------------- 合成
+def rgb565(c):
+    return ((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F)
+
+
+def mix(fg, bg, a):
+    out = 0
+    for sh in (16, 8, 0):
+        f, b = (fg >> sh) & 0xFF, (bg >> sh) & 0xFF
+        out |= ((b * (255 - a) + f * a + 127) // 255) << sh
+    return out
+
+
+def adv_px(g):
+    return (g["adv_w"] + 15) // 16      # adv_w 是 1/16 像素
+
+
+def render(font, code, cell_w, fg, bg):
+    start, length, id0 = font["range"]
+    if not start <= code < start + length:
+        sys.exit(f"U+{code:04X} not in font")
+    g = font["glyphs"][code - start + id0]
+
+    h = font["line_height"]
+    pix = [[bg] * cell_w for _ in range(h)]
+    alpha = glyph_alpha(font, g)
+
+    # 与 LVGL 一致：基线在行顶往下 line_height - base_line，字形框底边 = 基线 - ofs_y
+    top = (h - font["base_line"]) - g["box_h"] - g["ofs_y"]
+    left = (cell_w - adv_px(g)) // 2 + g["ofs_x"]
+    for y, row in enumerate(alpha):
+        for x, a in enumerate(row):
+            px, py = left + x, top + y
+            if a and 0 <= px < cell_w and 0 <= py < h:
+                pix[py][px] = mix(fg, bg, a)
+    return [rgb565(c) for r in pix for c in r]
+
+
+# ---------------------------------------------------------------- 输出
+def c_char(ch):
+    return "'\\''" if ch == "'" else "'\\\\'" if ch == "\\" else f"'{ch}'"
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--font", required=True, help="LVGL lv_font_*.c")
+    ap.add_argument("--name", required=True, help="symbol suffix: ui_atlas_<name>")
+    ap.add_argument("--fg", required=True, type=lambda s: int(s, 16), help="RRGGBB")
+    ap.add_argument("--bg", required=True, type=lambda s: int(s, 16), help="RRGGBB")
+    ap.add_argument("--chars", default=DEFAULT_CHARS)
+    ap.add_argument("--tabular", default=DEFAULT_TABULAR, help="chars drawn in a digit-wide cell")
+    ap.add_argument("--swap", action="store_true", help="emit panel (big-endian) byte order")
+    ap.add_argument("-o", "--output", required=True)
+    args = ap.parse_args()
+
+    font = parse_font(args.font)
+    start, _, id0 = font["range"]
+    digit_w = max(adv_px(font["glyphs"][ord(d) - start + id0]) for d in "0123456789")
+    h = font["line_height"]
+
+    sprites, data = [], bytearray()
+    for ch in args.chars:
+        w = digit_w if ch in args.tabular else adv_px(font["glyphs"][ord(ch) - start + id0])
+        px = render(font, ord(ch), w, args.fg, args.bg)
+        sprites.append((ch, w, len(data)))
+        for p in px:
+            data += p.to_bytes(2, "big" if args.swap else "little")
+
+    sym = f"ui_atlas_{args.name}"
+    out = [
+        "/* 由 scripts/gen_digit_atlas.py 生成，请勿手改 */",
+        f"/* font={args.font.replace(chr(92), '/').split('/')[-1]} fg=#{args.fg:06X} bg=#{args.bg:06X}"
+        f"{' swapped' if args.swap else ''} */",
+        "",
+        '#include "ui_digit_atlas.h"',
+        "",
+        f"static const uint8_t {sym}_px[{len(data)}] __aligned(4) = {{",
+    ]
+    for i in range(0, len(data), 16):
+        out.append("    " + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+    out += ["};", "", f"static const lv_image_dsc_t {sym}_img[{len(sprites)}] = {{"]
+    for ch, w, off in sprites:
+        out.append(
+            f"    {{ /* {c_char(ch)} */\n"
+            f"        .header = {{ .magic = LV_IMAGE_HEADER_MAGIC, .cf = LV_COLOR_FORMAT_RGB565,\n"
+            f"                    .w = {w}, .h = {h}, .stride = {w * 2} }},\n"
+            f"        .data_size = {w * h * 2},\n"
+            f"        .data = &{sym}_px[{off}],\n"
+            f"    }},")
+    out += [
+        "};",
+        "",
+        f"const struct ui_digit_atlas {sym} = {{",
+        f"    .glyphs  = \"{args.chars}\",",
+        f"    .imgs    = {sym}_img,",
+        f"    .n       = {len(sprites)},",
+        f"    .h       = {h},",
+        f"    .digit_w = {digit_w},",
+        f"    .fg      = 0x{args.fg:06X},",
+        f"    .bg      = 0x{args.bg:06X},",
+        f"    .swapped = {'true' if args.swap else 'false'},",
+        "};",
+        "",
+    ]
+    with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -3,22 +3,28 @@
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
-#include <zephyr/drivers/pwm.h>
 #include <zephyr/drivers/display.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/pm/device.h>
 #include <string.h>
 #if IS_ENABLED(CONFIG_SETTINGS)
 #include <zephyr/settings/settings.h>
 #endif
 
+#include "sensor/motion_state.h"
+#include "key_cmd.h"
+#include "bl_fade.h"
+#include "bl_schedule.h"
+#include "settings_cache.h"
+
 LOG_MODULE_REGISTER(blctl, LOG_LEVEL_INF);
 
-/* ==== Devicetree：要求 overlay 里有 aliases { bl = &backlight_pwm; } 且 chosen: zephyr,display ==== */
-#define BACKLIGHT_NODE   DT_ALIAS(backlight)
+/* ==== Devicetree：chosen: zephyr,display；背光 PWM 由 bl_fade 按 aliases { backlight } 取 ==== */
 #define DISP_NODE DT_CHOSEN(zephyr_display)
 
-static const struct pwm_dt_spec backlight_pwm = PWM_DT_SPEC_GET(BACKLIGHT_NODE);
 static const struct device       *display     = DEVICE_DT_GET(DISP_NODE);
 
 
@@ -32,70 +38,410 @@ static const struct device       *display     = DEVICE_DT_GET(DISP_NODE);
 #ifndef BLCTL_WAKE_THROTTLE_MS
 #define BLCTL_WAKE_THROTTLE_MS 1000   // 1s 内只生效一次；可在 prj.conf 用 -DBLCTL_WAKE_THROTTLE_MS=xxx 覆盖
 #endif
+/* 渐变参数：全部由 PWM DMA 回放，时长不影响 CPU 占用 */
+#ifndef BLCTL_FADE_IN_MS
+#define BLCTL_FADE_IN_MS       150
+#endif
+#ifndef BLCTL_FADE_OUT_MS
+#define BLCTL_FADE_OUT_MS      300
+#endif
+#ifndef BLCTL_SCHED_FADE_MS
+#define BLCTL_SCHED_FADE_MS    2000   /* 跨整点换时段系数时慢慢过渡，不让人察觉跳变 */
+#endif
+#ifndef BLCTL_DIM_PCT
+#define BLCTL_DIM_PCT          10     /* 熄屏前先降到这个亮度提示“快熄屏了” */
+#endif
+#ifndef BLCTL_DIM_LEAD_MS
+#define BLCTL_DIM_LEAD_MS      3000   /* 超时前多久开始变暗；超时到点时背光正好灭完 */
+#endif
+#ifndef BLCTL_AOD_DEFAULT
+#define BLCTL_AOD_DEFAULT      0      /* 常亮时钟默认关 */
+#endif
+#ifndef BLCTL_AOD_PCT
+#define BLCTL_AOD_PCT          5      /* 常亮时的背光亮度（再受用户亮度 × 时段系数封顶） */
+#endif
+#ifndef BLCTL_AOD_SETTLE_MS
+#define BLCTL_AOD_SETTLE_MS    100    /* 进 AOD 后等 UI 画好时钟再点背光，不露出上一帧 */
+#endif
+#ifndef BLCTL_AOD_WAKE_MAX_MS
+#define BLCTL_AOD_WAKE_MAX_MS  200    /* 离开 AOD 后等 UI 首帧的上限；超时照常渐亮 */
+#endif
+#ifndef BLCTL_OFF_DELAY_S
+#define BLCTL_OFF_DELAY_S      30     /* SLEEP 后再过多久让 ST7789 sleep-in；0=不进 OFF */
+#endif
+#ifndef BLCTL_WQ_STACK
+#define BLCTL_WQ_STACK         1536
+#endif
+#ifndef BLCTL_WQ_PRIO
+#define BLCTL_WQ_PRIO          5      /* 独立队列：唤醒不会排在系统队列里的 flash 写后面 */
+#endif
 
-static uint32_t s_last_wake_ms = 0;
-/* ==== 状态 & 设置（带持久化） ==== */
+/* ==== 状态 & 设置（带持久化） ====
+ *  AWAKE --(timeout-lead)--> DIMMED --(timeout)--> SLEEP --(OFF_DELAY)--> OFF
+ *    ^                          |                    |                     |
+ *    +--------------------- blctl_wake() ------------+---------------------+
+ *                               |
+ *                               +--(timeout, 常亮开)--> AOD --(blank / 静止)--> SLEEP
+ *                                                        |
+ *  AWAKE <----------------------- blctl_wake() ----------+
+ *
+ *  DIMMED：背光按 bl_fade 序列降到暗亮度并在超时点灭掉，屏幕内容仍可见
+ *  SLEEP ：背光灭 + display_blanking_on（DISPOFF），面板仍在线，唤醒最快
+ *  OFF   ：pm SUSPEND → ST7789 SLPIN，面板电流降到 uA 级，唤醒要多等一次 SLPOUT
+ *  AOD   ：面板不关，UI 切 idle 模式画分钟时钟，背光 BLCTL_AOD_PCT；主动熄屏 / 静止时转 SLEEP
+ * 每次状态变化发布到 blctl_state_chan，UI 线程据此整体暂停/恢复渲染。
+ *
+ * 线程模型：对外 API 可在任意线程（输入回调、传感器队列、按键、UI）调用，
+ * 只做原子置位 + 提交 s_bl_work；所有驱动调用和状态迁移都只发生在 s_bl_wq 上，
+ * 天然串行，不需要锁，调用方也不会碰到 PWM/SPI 驱动的锁。
+ */
+static atomic_t s_last_wake_ms   = ATOMIC_INIT(0);
 static uint32_t s_timeout_s      = BLCTL_TIMEOUT_S_DEFAULT;
 static uint8_t  s_brightness_pct = BLCTL_BRIGHTNESS_DEFAULT;
-static bool     s_awake          = false;
-  
-static struct k_work_delayable s_off_work;
+static atomic_t s_state          = ATOMIC_INIT(BLCTL_ST_SLEEP);   /* 上电时屏还没点亮 */
+static bool     s_aod_en         = BLCTL_AOD_DEFAULT;
+static bool     s_skip_aod;      /* 本次是主动熄屏：灭完直接 SLEEP，不进常亮；唤醒时清掉 */
+static bool     s_gram_aod;      /* 面板显存里是 AOD 时钟，LVGL 还没重画过 */
+static bool     s_fade_pending;  /* 已唤醒，等 UI 首帧再渐亮 */
+
+/* 请求位：多次请求在 worker 取走前自动合并 */
+#define REQ_WAKE        BIT(0)
+#define REQ_BLANK       BIT(1)
+#define REQ_TIMEOUT     BIT(2)   /* 超时设置变了，重排阶段定时器 */
+#define REQ_BRIGHTNESS  BIT(3)   /* 亮度变了，立即输出 */
+#define REQ_SCHEDULE    BIT(4)   /* 时段系数变了，缓慢过渡 */
+#define REQ_AOD         BIT(5)   /* 常亮开关变了：正在常亮且被关掉时转 SLEEP */
+#define REQ_UI_DRAWN    BIT(6)   /* UI 离开 AOD 后的第一帧已上屏 */
+static atomic_t s_req = ATOMIC_INIT(0);
+
+static K_THREAD_STACK_DEFINE(s_bl_wq_stack, BLCTL_WQ_STACK);
+static struct k_work_q s_bl_wq;
+
+static void bl_work_handler(struct k_work *work);
+static void stage_work_handler(struct k_work *work);
+static K_WORK_DEFINE(s_bl_work, bl_work_handler);
+static K_WORK_DELAYABLE_DEFINE(s_stage_work, stage_work_handler);   /* 驱动下一阶段的唯一定时器 */
+static void fade_in_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(s_fade_in_work, fade_in_work_handler); /* 等 UI 首帧的兜底 */
+
+static inline enum blctl_state state_get(void)
+{
+    return (enum blctl_state)atomic_get(&s_state);
+}
 
-/* ==== 内部工具 ==== */
-static inline uint32_t duty_ns(uint32_t period_ns, uint8_t pct)
+/* 任意线程：置请求位并唤醒 worker；队列未启动前的请求留在 s_req 里，init 时统一处理 */
+static inline void request(atomic_val_t bits)
 {
-    pct = CLAMP(pct, 0, 100);
-    if (pct == 0)       return 0;
-    if (pct >= 100)     return period_ns;
-    return (uint32_t)((uint64_t)period_ns * pct / 100U);
+    atomic_or(&s_req, bits);
+    (void)k_work_submit_to_queue(&s_bl_wq, &s_bl_work);
 }
 
+ZBUS_CHAN_DEFINE(blctl_state_chan, struct blctl_state_msg, NULL, NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(.state = BLCTL_ST_SLEEP));
 
 #if IS_ENABLED(CONFIG_SETTINGS)
-/* settings: /blctl/{timeout_s,brightness_pct} */
-static int blctrl_settings_set(const char *name, size_t len, settings_read_cb read_cb, 
+/* settings: /blctl/{timeout_s,brightness_pct,aod} */
+static int blctl_settings_set(const char *name, size_t len, settings_read_cb read_cb, 
                                                                         void *cb_arg)
 { 
     if (!strcmp(name, "timeout_s") && len == sizeof(uint32_t)) {
         (void)read_cb(cb_arg, &s_timeout_s, sizeof(uint32_t));
+        settings_cache_seed("blctl/timeout_s", &s_timeout_s, sizeof(s_timeout_s));
         return 0;
     } else if (!strcmp(name, "brightness_pct") && len == sizeof(uint8_t)) {
         (void)read_cb(cb_arg, &s_brightness_pct, sizeof(uint8_t));
+        settings_cache_seed("blctl/brightness_pct", &s_brightness_pct, sizeof(s_brightness_pct));
         s_brightness_pct = CLAMP(s_brightness_pct, 0, 100);
         return 0;
+    } else if (!strcmp(name, "aod") && len == sizeof(uint8_t)) {
+        uint8_t v = 0;
+        if (read_cb(cb_arg, &v, sizeof(v)) != sizeof(v)) return -EIO;
+        settings_cache_seed("blctl/aod", &v, sizeof(v));
+        s_aod_en = (v != 0);
+        return 0;
     }
     return -ENOENT;
 }
 
 SETTINGS_STATIC_HANDLER_DEFINE(blctl, "blctl", NULL, blctl_settings_set, NULL, NULL);
+/* 经写回缓存落盘：拖动滑块只改 RAM，静默后或熄屏时一次写 flash */
 static inline void blctl_save_timeout(void)
 {
-    (void)settings_save_one("blctl/timeout_s", &s_timeout_s, sizeof(s_timeout_s));
+    (void)settings_cache_put("blctl/timeout_s", &s_timeout_s, sizeof(s_timeout_s));
 }
 static inline void blctl_save_brightness(void)
 {
-    (void)settings_save_one("blctl/brightness_pct", &s_brightness_pct, sizeof(s_brightness_pct));
+    (void)settings_cache_put("blctl/brightness_pct", &s_brightness_pct, sizeof(s_brightness_pct));
+}
+static inline void blctl_save_aod(void)
+{
+    const uint8_t v = s_aod_en ? 1U : 0U;
+    (void)settings_cache_put("blctl/aod", &v, sizeof(v));
 }
 #else
 static inline void blctl_save_timeout(void)     {}
 static inline void blctl_save_brightness(void)  {}
+static inline void blctl_save_aod(void)         {}
 #endif
 
-/* ==== 自动熄灭 ==== */
-static void off_work_handler(struct k_work *work)
+/* 实际输出亮度：用户亮度 × 当前时段系数（见 bl_schedule.h） */
+static inline uint8_t target_pct(void)
 {
-    ARG_UNUSED(work);
-    /* 先关背光，再 blank 屏 */
-    if (device_is_ready(backlight_pwm.dev)) {
-        (void)pwm_set_dt(&backlight_pwm, backlight_pwm.period, 0);
+    return bl_schedule_apply(s_brightness_pct);
+}
+
+/* ==== 状态迁移（只在 s_bl_wq 上执行） ==== */
+static void set_state(enum blctl_state st)
+{
+    if (state_get() == st) return;
+    atomic_set(&s_state, st);
+
+    const struct blctl_state_msg m = { .state = (uint8_t)st };
+    (void)zbus_chan_pub(&blctl_state_chan, &m, K_MSEC(10));
+}
+
+/* 亮屏期间：排到“开始变暗”的时刻；超时=0 则不排 */
+static void schedule_dim(void)
+{
+    if (s_timeout_s == 0) {
+        (void)k_work_cancel_delayable(&s_stage_work);
+        return;
     }
+    uint32_t to_ms = s_timeout_s * 1000U;
+    uint32_t at_ms = (to_ms > BLCTL_DIM_LEAD_MS) ? (to_ms - BLCTL_DIM_LEAD_MS) : 0U;
+    k_work_reschedule_for_queue(&s_bl_wq, &s_stage_work, K_MSEC(at_ms));
+}
+
+/* 进入 DIMMED：hold 取到超时点为止，保证用户设置的超时仍是“完全熄灭”的时刻 */
+static void enter_dimmed(uint32_t remaining_ms)
+{
+    uint32_t hold = (remaining_ms > 2U * BLCTL_FADE_OUT_MS) ?
+                    (remaining_ms - 2U * BLCTL_FADE_OUT_MS) : 0U;
+    uint32_t ms = bl_fade_dim_then_off(MIN(BLCTL_DIM_PCT, target_pct()),
+                                       BLCTL_FADE_OUT_MS, hold);
+    set_state(BLCTL_ST_DIMMED);
+    k_work_reschedule_for_queue(&s_bl_wq, &s_stage_work, K_MSEC(ms));
+}
+
+static void enter_sleep(void)
+{
     if (device_is_ready(display)) {
         (void)display_blanking_on(display);
     }
-    s_awake = false;
+    set_state(BLCTL_ST_SLEEP);
     LOG_INF("BL OFF, display blank");
+
+    /* 屏幕不可见：此时写 flash 不会造成可感知的卡顿 */
+    settings_cache_flush();
+
+    if (BLCTL_OFF_DELAY_S > 0) {
+        k_work_reschedule_for_queue(&s_bl_wq, &s_stage_work, K_SECONDS(BLCTL_OFF_DELAY_S));
+    }
+}
+
+/* 进入 AOD：先发状态让 UI 清屏画时钟，背光（此时已灭）在 SETTLE 之后由 stage 定时器点亮 */
+static void enter_aod(void)
+{
+    s_gram_aod = true;
+    set_state(BLCTL_ST_AOD);
+    LOG_INF("always-on clock");
+
+    /* 与 SLEEP 一样：屏上只剩静态时钟，写 flash 不会有可感知的卡顿 */
+    settings_cache_flush();
+
+    k_work_reschedule_for_queue(&s_bl_wq, &s_stage_work, K_MSEC(BLCTL_AOD_SETTLE_MS));
+}
+
+static void enter_off(void)
+{
+#if IS_ENABLED(CONFIG_PM_DEVICE)
+    if (device_is_ready(display)) {
+        int r = pm_device_action_run(display, PM_DEVICE_ACTION_SUSPEND);
+        if (r && r != -EALREADY) {
+            LOG_WRN("display suspend ret=%d, stay in SLEEP", r);
+            return;
+        }
+    }
+#endif
+    set_state(BLCTL_ST_OFF);
+    LOG_INF("display sleep-in");
+}
+
+static void stage_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    switch (state_get()) {
+    case BLCTL_ST_AWAKE:
+        enter_dimmed(MIN(s_timeout_s * 1000U, BLCTL_DIM_LEAD_MS));
+        break;
+    case BLCTL_ST_DIMMED:
+        if (s_aod_en && !s_skip_aod) {
+            enter_aod();
+        } else {
+            enter_sleep();
+        }
+        break;
+    case BLCTL_ST_SLEEP:
+        enter_off();
+        break;
+    case BLCTL_ST_AOD:
+        /* 两种到点：进 AOD 后的 SETTLE（点背光），或主动熄屏/关常亮后的渐灭结束 */
+        if (s_skip_aod || !s_aod_en) {
+            enter_sleep();
+        } else {
+            bl_fade_to(MIN(BLCTL_AOD_PCT, target_pct()), BLCTL_FADE_IN_MS);
+        }
+        break;
+    default:
+        break;
+    }
 }
 
+static void do_wake(void)
+{
+    /* 亮屏是时段求值的时机之一：熄屏期间跨过的整点在这里补上 */
+    if (state_get() != BLCTL_ST_AWAKE) {
+        (void)bl_schedule_eval();
+    }
+
+    switch (state_get()) {
+    case BLCTL_ST_OFF:
+#if IS_ENABLED(CONFIG_PM_DEVICE)
+        if (device_is_ready(display)) {
+            int r = pm_device_action_run(display, PM_DEVICE_ACTION_RESUME);
+            if (r && r != -EALREADY) LOG_WRN("display resume ret=%d", r);
+        }
+#endif
+        __fallthrough;
+    case BLCTL_ST_SLEEP:
+        if (device_is_ready(display)) {
+            int r = display_blanking_off(display);
+            if (r) LOG_WRN("display_blanking_off ret=%d", r);
+        }
+        __fallthrough;
+    case BLCTL_ST_AOD:
+        /* AOD 面板一直开着；UI 收到 AWAKE 后自己退出 idle 模式并整屏重画 */
+        __fallthrough;
+    case BLCTL_ST_DIMMED:
+        if (s_gram_aod) {
+            /* 屏上还是 AOD 时钟：等 UI 画完第一帧（blctl_ui_drawn）再亮，与进 AOD 时的 SETTLE 对称 */
+            s_fade_pending = true;
+            k_work_reschedule_for_queue(&s_bl_wq, &s_fade_in_work, K_MSEC(BLCTL_AOD_WAKE_MAX_MS));
+        } else {
+            /* DIMMED 时屏还亮着，从当前亮度渐亮回来即可 */
+            bl_fade_to(target_pct(), BLCTL_FADE_IN_MS);
+        }
+        break;
+    default:
+        break;
+    }
+
+    s_skip_aod = false;
+    set_state(BLCTL_ST_AWAKE);
+    schedule_dim();
+}
+
+/* 推迟的唤醒渐亮：UI 首帧上屏或兜底超时，先到者执行 */
+static void fade_in_pending(void)
+{
+    if (!s_fade_pending) return;
+    s_fade_pending = false;
+    (void)k_work_cancel_delayable(&s_fade_in_work);
+    if (state_get() == BLCTL_ST_AWAKE) {
+        bl_fade_to(target_pct(), BLCTL_FADE_IN_MS);
+    }
+}
+
+static void fade_in_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+    if (s_fade_pending) {
+        LOG_WRN("no UI frame after AOD, fading in anyway");
+        s_gram_aod = false;
+    }
+    fade_in_pending();
+}
+
+static void do_blank(void)
+{
+    enum blctl_state st = state_get();
+    s_fade_pending = false;
+    if (st == BLCTL_ST_AWAKE || st == BLCTL_ST_DIMMED) {
+        /* 主动熄屏不做“先暗”提示：直接渐灭，播完进 SLEEP */
+        bl_fade_to(0, BLCTL_FADE_OUT_MS);
+        s_skip_aod = true;
+        set_state(BLCTL_ST_DIMMED);
+        k_work_reschedule_for_queue(&s_bl_wq, &s_stage_work, K_MSEC(BLCTL_FADE_OUT_MS));
+    } else if (st == BLCTL_ST_AOD) {
+        /* 常亮中主动熄屏：留在 AOD 把背光灭完，再由 stage 定时器转 SLEEP */
+        bl_fade_to(0, BLCTL_FADE_OUT_MS);
+        s_skip_aod = true;
+        k_work_reschedule_for_queue(&s_bl_wq, &s_stage_work, K_MSEC(BLCTL_FADE_OUT_MS));
+    }
+}
+
+/* 唯一的执行者：一次取走全部请求位。同一批里既有熄又有亮时以亮为准（用户操作优先） */
+static void bl_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    atomic_val_t req = atomic_clear(&s_req);
+
+    if ((req & REQ_BLANK) && !(req & REQ_WAKE)) {
+        do_blank();
+    }
+    if (req & REQ_WAKE) {
+        do_wake();
+    }
+    if (req & REQ_UI_DRAWN) {
+        s_gram_aod = false;             /* 即使中途又熄屏了，显存也已是 LVGL 画面 */
+        fade_in_pending();
+    }
+    if ((req & REQ_TIMEOUT) && state_get() == BLCTL_ST_AWAKE) {
+        schedule_dim();
+    }
+    if ((req & REQ_BRIGHTNESS) && state_get() == BLCTL_ST_AWAKE) {
+        /* 滑块拖动时连续调用，直接跳到目标值更跟手 */
+        bl_fade_to(target_pct(), 0);
+    } else if ((req & REQ_SCHEDULE) && state_get() == BLCTL_ST_AWAKE) {
+        bl_fade_to(target_pct(), BLCTL_SCHED_FADE_MS);
+    }
+    if ((req & REQ_AOD) && !s_aod_en && state_get() == BLCTL_ST_AOD) {
+        bl_fade_to(0, BLCTL_FADE_OUT_MS);
+        k_work_reschedule_for_queue(&s_bl_wq, &s_stage_work, K_MSEC(BLCTL_FADE_OUT_MS));
+    }
+}
+
+/* ==== 运动状态：静止（如放在床头柜）时立即熄屏，不再等超时 ==== */
+static void blctl_motion_cb(const struct zbus_channel *chan)
+{
+    const struct motion_msg *m = zbus_chan_const_msg(chan);
+
+    /* 超时=0（永不熄灭）视为用户明确要求常亮，不干预；放下不戴时常亮时钟也没人看 */
+    enum blctl_state st = state_get();
+    if (m->state == MOTION_STATIONARY && s_timeout_s != 0 &&
+        (st == BLCTL_ST_AWAKE || st == BLCTL_ST_AOD)) {
+        LOG_INF("wearer stationary -> blank");
+        blctl_blank();
+    }
+}
+ZBUS_LISTENER_DEFINE(blctl_motion_listener, blctl_motion_cb);
+ZBUS_CHAN_ADD_OBS(motion_chan, blctl_motion_listener, 3);
+
+/* ==== 按键命令：单击只在没亮屏时点亮（与原行为一致，亮屏时不续超时）；回表盘总是先点亮 ==== */
+static void blctl_key_cb(const struct zbus_channel *chan)
+{
+    const struct key_cmd_msg *m = zbus_chan_const_msg(chan);
+
+    if ((m->cmd == KEY_CMD_WAKE && !blctl_is_awake()) || m->cmd == KEY_CMD_HOME) {
+        blctl_wake();
+    }
+}
+ZBUS_LISTENER_DEFINE(blctl_key_listener, blctl_key_cb);
+ZBUS_CHAN_ADD_OBS(key_cmd_chan, blctl_key_listener, 3);
+
 /* ==== 实现 ==== */
 int blctl_init(void)
 {
@@ -103,79 +449,59 @@ int blctl_init(void)
     (void)settings_subsys_init();
     (void)settings_load();             /* 可能会覆盖默认 s_timeout_s / s_brightness_pct */
 #endif
-    if (!device_is_ready(backlight_pwm.dev)) {
-        LOG_ERR("PWM backlight not ready");
+    int ret = bl_fade_init();
+    if (ret) {
+        LOG_ERR("PWM backlight not ready: %d", ret);
         return -ENODEV;
     }
     if (!device_is_ready(display)) {
         LOG_WRN("Display not ready");
     }
 
-    k_work_init_delayable(&s_off_work, off_work_handler);
-    blctl_wake();
-    LOG_INF("blctl ready: timeout=%us, brightness=%u%%", s_timeout_s, s_brightness_pct);
+    const struct k_work_queue_config cfg = { .name = "blctl_wq" };
+    k_work_queue_start(&s_bl_wq, s_bl_wq_stack, K_THREAD_STACK_SIZEOF(s_bl_wq_stack),
+                       BLCTL_WQ_PRIO, &cfg);
+
+    /* 初始化前各处提交的请求都还在 s_req 里，这里一并触发 */
+    request(REQ_WAKE);
+    LOG_INF("blctl ready: timeout=%us, brightness=%u%%, aod=%d",
+            s_timeout_s, s_brightness_pct, s_aod_en);
     return 0;    
 }
 
+/* 热路径：每个触摸采样都可能调用。节流窗口内只有一次时间读取和两次原子读 */
 void blctl_wake(void)
 {
     uint32_t now = k_uptime_get_32();
 
-    /* 若已是亮屏且在节流窗口内，直接返回：避免频繁 display/pwm/重排定时器 */
-    if (s_awake && BLCTL_WAKE_THROTTLE_MS > 0 &&
-        (uint32_t)(now - s_last_wake_ms) < BLCTL_WAKE_THROTTLE_MS) {
+    if (state_get() == BLCTL_ST_AWAKE && BLCTL_WAKE_THROTTLE_MS > 0 &&
+        (uint32_t)(now - (uint32_t)atomic_get(&s_last_wake_ms)) < BLCTL_WAKE_THROTTLE_MS) {
         return;
     }
-    s_last_wake_ms = now;
-
-    if (device_is_ready(display)) {
-        int r = display_blanking_off(display);
-        if (r) LOG_WRN("display_blanking_off ret=%d", r);
-    }
-    if (device_is_ready(backlight_pwm.dev)) {
-        int r = pwm_set_dt(&backlight_pwm, backlight_pwm.period, duty_ns(backlight_pwm.period, s_brightness_pct));
-        if (r) LOG_WRN("pwm_set_dt ON ret=%d", r);
-    }
-    s_awake = true;
-
-    if (s_timeout_s == 0) {
-        (void)k_work_cancel_delayable(&s_off_work);
-    } else {
-        k_work_reschedule(&s_off_work, K_SECONDS(s_timeout_s));
-    }
+    atomic_set(&s_last_wake_ms, (atomic_val_t)now);
+    request(REQ_WAKE);
 }
 
 void blctl_blank(void)
 {
-    (void)k_work_cancel_delayable(&s_off_work);
-
-    if (device_is_ready(backlight_pwm.dev)) {
-        (void)pwm_set_dt(&backlight_pwm, backlight_pwm.period, 0);
-    }
-    if (device_is_ready(display)) {
-        (void)display_blanking_on(display);
-    }
-    s_awake = false;
-    LOG_INF("BL OFF, display blank");
+    request(REQ_BLANK);
 }
 
 bool blctl_is_awake(void)
 {
-    return s_awake;
+    return state_get() == BLCTL_ST_AWAKE;
+}
+
+enum blctl_state blctl_get_state(void)
+{
+    return state_get();
 }
 
 int blctl_set_timeout(uint32_t sec, bool persist)
 {
     s_timeout_s = sec;
     if (persist) blctl_save_timeout();
-
-    if (s_awake) {
-        if (s_timeout_s == 0) {
-            (void)k_work_cancel_delayable(&s_off_work);
-        } else {
-            k_work_reschedule(&s_off_work, K_SECONDS(s_timeout_s));
-        }
-    }
+    request(REQ_TIMEOUT);
     return 0;
 }
 
@@ -188,10 +514,7 @@ int blctl_set_brightness(uint8_t pct, bool persist)
 {
     s_brightness_pct = CLAMP(pct, 0, 100);
     if (persist) blctl_save_brightness();
-
-    if (s_awake && device_is_ready(backlight_pwm.dev)) {
-        (void)pwm_set_dt(&backlight_pwm, backlight_pwm.period, duty_ns(backlight_pwm.period, s_brightness_pct));
-    }
+    request(REQ_BRIGHTNESS);
     return 0;
 }
 
@@ -200,3 +523,25 @@ uint8_t blctl_get_brightness(void)
     return s_brightness_pct;
 }
 
+int blctl_set_aod(bool en, bool persist)
+{
+    s_aod_en = en;
+    if (persist) blctl_save_aod();
+    request(REQ_AOD);
+    return 0;
+}
+
+bool blctl_get_aod(void)
+{
+    return s_aod_en;
+}
+
+void blctl_ui_drawn(void)
+{
+    request(REQ_UI_DRAWN);
+}
+
+void blctl_refresh_brightness(void)
+{
+    request(REQ_SCHEDULE);
+}
@@ -5,9 +5,18 @@
  * @file backlight_ctrl.h
  * @brief 屏幕亮灭与PWM背光控制（带自动熄灭、亮度设置、可持久化）
  *
+ * 所有 API 线程安全、可在任意线程调用：只置原子请求位，由内部 worker 统一执行，
+ * 调用方不会进入 PWM/显示驱动。blctl_wake() 在 1s 节流窗口内几乎零开销。
+ *
+ * 亮/灭都是渐变（见 bl_fade.h）。超时分阶段：AWAKE → DIMMED → SLEEP → OFF，
+ * 打开常亮时 DIMMED 之后进 AOD 并停在那里（不进 SLEEP/OFF）。
+ * 每次切换发布到 blctl_state_chan，UI 在 SLEEP/OFF/AOD 时停止 LVGL 渲染。
+ *
+ * 实际输出亮度 = 用户亮度 × 时段系数（bl_schedule.h，夜间自动调暗）。
+ *
  * 依赖：
- *  - Devicetree: aliases { bl = &backlight_pwm; }，chosen: zephyr,display
- *  - Kconfig/prj.conf: CONFIG_GPIO, CONFIG_PWM, CONFIG_DISPLAY, CONFIG_LOG
+ *  - Devicetree: aliases { backlight = &backlight_pwm; }，chosen: zephyr,display
+ *  - Kconfig/prj.conf: CONFIG_GPIO, CONFIG_NRFX_PWM0, CONFIG_DISPLAY, CONFIG_LOG
  *    可选持久化：CONFIG_FLASH, CONFIG_NVS, CONFIG_SETTINGS, CONFIG_SETTINGS_NVS
  *
  * 说明：
@@ -17,11 +26,28 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <zephyr/zbus/zbus.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** 显示电源状态 */
+enum blctl_state {
+    BLCTL_ST_AWAKE = 0,   /**< 正常亮度 */
+    BLCTL_ST_DIMMED,      /**< 即将熄屏：背光变暗/渐灭中，内容仍可见 */
+    BLCTL_ST_SLEEP,       /**< 背光灭 + DISPOFF，屏幕不可见 */
+    BLCTL_ST_OFF,         /**< 面板 sleep-in（pm SUSPEND） */
+    BLCTL_ST_AOD,         /**< 常亮：面板 idle 模式 + 低背光，UI 只画分钟级时钟（ui_aod.h） */
+};
+
+struct blctl_state_msg {
+    uint8_t state;        /**< enum blctl_state */
+};
+
+/** 状态变化通知；订阅者用 ZBUS_CHAN_ADD_OBS 挂上来 */
+ZBUS_CHAN_DECLARE(blctl_state_chan);
+
 /** 初始化背光/屏幕控制模块 */
 int      blctl_init(void);
 
@@ -31,9 +57,12 @@ void     blctl_wake(void);
 /** 立即熄灭背光并 blank 屏幕（取消自动熄灭计时） */
 void     blctl_blank(void);
 
-/** 当前是否处于“已亮屏”状态 */
+/** 当前是否处于“已亮屏”状态（仅 AWAKE；DIMMED 也算需要唤醒） */
 bool     blctl_is_awake(void);
 
+/** 当前显示电源状态 */
+enum blctl_state blctl_get_state(void);
+
 /** 设置自动熄灭时间（秒）；0=永不；persist=true 写入 settings */
 int      blctl_set_timeout(uint32_t sec, bool persist);
 
@@ -43,9 +72,21 @@ uint32_t blctl_get_timeout(void);
 /** 设置亮度（0~100%）；persist=true 写入 settings；若已亮屏立即生效 */
 int      blctl_set_brightness(uint8_t pct, bool persist);
 
-/** 获取当前亮度（0~100%） */
+/** 获取当前亮度（0~100%，用户设置值，未乘时段系数） */
 uint8_t  blctl_get_brightness(void);
 
+/** 打开/关闭超时后的常亮时钟；persist=true 写入 settings。主动熄屏和静止熄屏不进常亮 */
+int      blctl_set_aod(bool en, bool persist);
+
+/** 常亮时钟是否打开 */
+bool     blctl_get_aod(void);
+
+/** UI 线程：离开 AOD 后第一帧 LVGL 画面已写到面板；推迟的唤醒渐亮从这里开始 */
+void     blctl_ui_drawn(void);
+
+/** 时段系数变化后调用：亮屏时按新系数缓慢过渡到目标亮度 */
+void     blctl_refresh_brightness(void);
+
 #ifdef __cplusplus
 }
 #endif
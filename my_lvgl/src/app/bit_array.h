@@ -66,7 +66,13 @@ typedef bit_array_t bit_array_val_t;
  */
 #define BIT_ARRAY_DEFINE(name, num_bits) bit_array_t name[BIT_ARRAY_BITMAP_SIZE(num_bits)]
 
-#if 1
+// Use the compiler builtin only where it maps to a popcount instruction (x86 POPCNT, AArch64 CNT).
+// On Cortex-M it becomes a libgcc table-lookup call, which is slower than the inline SWAR below.
+#if defined(__GNUC__) && (defined(__POPCNT__) || defined(__aarch64__))
+#define BIT_ARRAY_HAS_HW_POPCOUNT 1
+#endif
+
+#ifndef BIT_ARRAY_HAS_HW_POPCOUNT
 // See http://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetParallel
 static inline bit_array_val_t _windows_popcount(bit_array_val_t w)
 {
@@ -77,8 +83,10 @@ static inline bit_array_val_t _windows_popcount(bit_array_val_t w)
 }
 
 #define POPCOUNT(x) _windows_popcount(x)
-#else
+#elif defined(BIT_ARRAY_CONFIG_64)
 #define POPCOUNT(x) (unsigned)__builtin_popcountll(x)
+#else
+#define POPCOUNT(x) (unsigned)__builtin_popcount(x)
 #endif
 
 #define bits_in_top_word(nbits) ((nbits) ? BIT_ARRAY_BIT_INDEX((nbits)-1) + 1 : 0)
@@ -406,12 +414,17 @@ static inline void _bit_array_set_region(bit_array_t *target, int start, int len
 }
 
 // Get the number of bits set (hamming weight)
-static inline int bit_array_num_bits_set(bit_array_t *target, int num_bits)
+static inline int bit_array_num_bits_set(const bit_array_t *target, int num_bits)
 {
     int i;
 
     int num_of_bits_set = 0;
 
+    if (BIT_ARRAY_BITMAP_SIZE(num_bits) == 1)
+    {
+        return POPCOUNT(target[0]);
+    }
+
     for (i = 0; i < BIT_ARRAY_BITMAP_SIZE(num_bits); i++)
     {
         if (target[i] > 0)
@@ -423,6 +436,25 @@ static inline int bit_array_num_bits_set(bit_array_t *target, int num_bits)
     return num_of_bits_set;
 }
 
+// Check whether any bit is set; stops at the first non-zero word.
+// Cheaper than `bit_array_num_bits_set() != 0` when only emptiness matters.
+static inline int bit_array_any(const bit_array_t *target, int num_bits)
+{
+    if (BIT_ARRAY_BITMAP_SIZE(num_bits) == 1)
+    {
+        return target[0] != 0;
+    }
+
+    for (int i = 0; i < BIT_ARRAY_BITMAP_SIZE(num_bits); i++)
+    {
+        if (target[i])
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 // Get the number of bits not set (1 - hamming weight)
 static inline int bit_array_num_bits_cleared(bit_array_t *target, int num_bits)
 {
@@ -590,6 +622,59 @@ static inline int bit_array_cmp(const bit_array_t *bitarr1, const bit_array_t *b
     return memcmp(bitarr1, bitarr2, BIT_ARRAY_BITMAP_SIZE(num_bits) * sizeof(bit_array_val_t));
 }
 
+// Equality only, word by word with early exit (no memcmp call).
+static inline int bit_array_equal(const bit_array_t *bitarr1, const bit_array_t *bitarr2, int num_bits)
+{
+    if (BIT_ARRAY_BITMAP_SIZE(num_bits) == 1)
+    {
+        return bitarr1[0] == bitarr2[0];
+    }
+
+    for (int i = 0; i < BIT_ARRAY_BITMAP_SIZE(num_bits); i++)
+    {
+        if (bitarr1[i] != bitarr2[i])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Fused `(src & mask) == mask`: every bit of mask is also set in src.
+// Same result as bit_array_and() into a temporary followed by bit_array_cmp() == 0,
+// without the temporary, the second pass or the memcmp call; stops at the first missing bit.
+static inline int bit_array_and_cmp_eq(const bit_array_t *src, const bit_array_t *mask, int num_bits)
+{
+    if (BIT_ARRAY_BITMAP_SIZE(num_bits) == 1)
+    {
+        return (src[0] & mask[0]) == mask[0];
+    }
+
+    for (int i = 0; i < BIT_ARRAY_BITMAP_SIZE(num_bits); i++)
+    {
+        if ((src[i] & mask[i]) != mask[i])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+//
+// Word access (no bounds checking)
+//
+
+// Store a whole word; used to build state arrays word by word instead of bit by bit.
+static inline void bit_array_set_word_at(bit_array_t *target, int word_index, bit_array_val_t word)
+{
+    target[word_index] = word;
+}
+
+static inline bit_array_val_t bit_array_get_word_at(const bit_array_t *target, int word_index)
+{
+    return target[word_index];
+}
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
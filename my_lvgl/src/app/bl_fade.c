@@ -0,0 +1,248 @@
+// bl_fade.c
+#include "bl_fade.h"
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/pinctrl.h>
+#include <zephyr/dt-bindings/pwm/pwm.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include <nrfx_pwm.h>
+
+LOG_MODULE_REGISTER(bl_fade, LOG_LEVEL_INF);
+
+/* ==== Devicetree：沿用 backlight 别名里的 pwms 描述，只换掉驱动 ==== */
+#define BACKLIGHT_NODE   DT_ALIAS(backlight)
+#define BL_PWM_NODE      DT_PWMS_CTLR(BACKLIGHT_NODE)
+#define BL_PWM_INST_IDX  0
+
+BUILD_ASSERT(DT_SAME_NODE(BL_PWM_NODE, DT_NODELABEL(pwm0)),
+             "backlight pwms must point at &pwm0 (BL_PWM_INST_IDX)");
+BUILD_ASSERT(DT_PWMS_CHANNEL(BACKLIGHT_NODE) == 0,
+             "backlight must be on PWM channel 0 (OUT0)");
+BUILD_ASSERT(!(DT_PWMS_FLAGS(BACKLIGHT_NODE) & PWM_POLARITY_INVERTED),
+             "only PWM_POLARITY_NORMAL is supported");
+BUILD_ASSERT(!DT_NODE_HAS_STATUS(BL_PWM_NODE, okay),
+             "set &pwm0 status = \"disabled\" so the Zephyr PWM driver does not own it");
+
+PINCTRL_DT_DEFINE(BL_PWM_NODE);
+
+/* 16MHz 计数，COUNTERTOP 由 DT 周期换算：100us → 1600 级，gamma 低端也有足够分辨率 */
+#define BL_PERIOD_NS     DT_PWMS_PERIOD(BACKLIGHT_NODE)
+#define BL_PERIOD_US     (BL_PERIOD_NS / 1000U)
+#define BL_TOP           (BL_PERIOD_NS * 16U / 1000U)
+BUILD_ASSERT(BL_TOP > 0 && BL_TOP <= 0x7FFF, "backlight PWM period out of range");
+
+/* bit15=1：每个周期先高后低，即高电平有效（与 Zephyr pwm_nrfx 的 NORMAL 一致） */
+#define BL_POL_NORMAL    0x8000U
+
+#ifndef BL_FADE_MAX_STEPS
+#define BL_FADE_MAX_STEPS 64     /* 每段渐变最多点数；每点 2B，×4 个缓冲 */
+#endif
+#define BL_SEQ_MAX        0xFFFFFFU /* REFRESH / ENDDELAY 寄存器 24 位 */
+
+/* 感知亮度 0..100% → 线性占空比（Q16），gamma 2.2 */
+static const uint16_t s_gamma[101] = {
+        0,     3,    12,    29,    55,    90,   134,   189,   253,   328,
+      413,   510,   618,   736,   867,  1009,  1163,  1329,  1507,  1697,
+     1900,  2115,  2343,  2584,  2838,  3104,  3384,  3677,  3983,  4303,
+     4636,  4983,  5343,  5717,  6106,  6508,  6924,  7354,  7798,  8257,
+     8730,  9217,  9719, 10235, 10766, 11312, 11872, 12448, 13038, 13643,
+    14263, 14898, 15548, 16214, 16894, 17590, 18302, 19028, 19770, 20528,
+    21301, 22090, 22895, 23715, 24551, 25403, 26271, 27154, 28054, 28970,
+    29901, 30849, 31813, 32793, 33790, 34802, 35831, 36877, 37939, 39017,
+    40112, 41223, 42351, 43496, 44657, 45835, 47029, 48241, 49469, 50714,
+    51976, 53255, 54551, 55864, 57195, 58542, 59906, 61287, 62686, 64102,
+    65535,
+};
+
+static const nrfx_pwm_t s_pwm = NRFX_PWM_INSTANCE(BL_PWM_INST_IDX);
+static bool s_ready;
+static struct k_spinlock s_lock;
+
+/* EasyDMA 直接从这里取值，必须在 RAM 且回放期间不能改：
+ * 4 个缓冲轮流用，一次回放最多占 2 个，新渐变永远写不到正在播的那块 */
+static uint16_t s_buf[4][BL_FADE_MAX_STEPS];
+static uint8_t  s_buf_next;
+
+/* 回放时间线：用于估算“现在亮度是多少”，以便打断时从当前值接着渐变 */
+#define BL_TL_MAX 4
+static struct {
+    int64_t  t0;
+    uint8_t  n;
+    uint32_t t[BL_TL_MAX];   /* 相对 t0 的 ms */
+    uint8_t  v[BL_TL_MAX];   /* 该时刻亮度 % */
+} s_tl;
+
+static uint16_t *next_buf(void)
+{
+    uint16_t *b = s_buf[s_buf_next];
+    s_buf_next = (s_buf_next + 1U) & 3U;
+    return b;
+}
+
+/* pct_q8 = 百分比 × 256，在 gamma 表中线性插值后换算成 COUNTERTOP 刻度 */
+static uint16_t duty_of_q8(uint32_t pct_q8)
+{
+    uint32_t i = pct_q8 >> 8;
+    uint32_t g;
+
+    if (i >= 100) {
+        g = s_gamma[100];
+    } else {
+        uint32_t f = pct_q8 & 0xFFU;
+        g = s_gamma[i] + (((uint32_t)(s_gamma[i + 1] - s_gamma[i]) * f) >> 8);
+    }
+
+    uint32_t d = (g * BL_TOP + 0x8000U) >> 16;
+    if (d == 0 && pct_q8 > 0) d = 1;    /* 非 0 亮度至少给 1 个计数 */
+    return (uint16_t)d;
+}
+
+/* from→to 的渐变写进 buf：返回点数，并填好每点的重复周期数 */
+static uint16_t build_ramp(uint16_t *buf, uint8_t from, uint8_t to, uint32_t ms,
+                           uint32_t *repeats)
+{
+    uint32_t periods = (uint32_t)((uint64_t)ms * 1000U / BL_PERIOD_US);
+    uint32_t n = (from == to) ? 1U : CLAMP(periods, 1U, BL_FADE_MAX_STEPS);
+
+    *repeats = (periods > n) ? MIN(periods / n - 1U, BL_SEQ_MAX) : 0U;
+
+    int32_t span = ((int32_t)to - (int32_t)from) * 256;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t q8 = (uint32_t)((int32_t)from * 256 + span * (int32_t)(i + 1U) / (int32_t)n);
+        buf[i] = duty_of_q8(q8) | BL_POL_NORMAL;
+    }
+    return (uint16_t)n;
+}
+
+static uint8_t level_at(int64_t now)
+{
+    if (s_tl.n == 0) return 0;
+
+    uint32_t dt = (uint32_t)MIN(now - s_tl.t0, (int64_t)UINT32_MAX);
+    if (dt >= s_tl.t[s_tl.n - 1]) return s_tl.v[s_tl.n - 1];
+
+    for (uint8_t k = 0; k + 1 < s_tl.n; k++) {
+        if (dt < s_tl.t[k + 1]) {
+            uint32_t seg = s_tl.t[k + 1] - s_tl.t[k];
+            int32_t  dv  = (int32_t)s_tl.v[k + 1] - (int32_t)s_tl.v[k];
+            if (seg == 0) return s_tl.v[k + 1];
+            return (uint8_t)((int32_t)s_tl.v[k] + dv * (int32_t)(dt - s_tl.t[k]) / (int32_t)seg);
+        }
+    }
+    return s_tl.v[s_tl.n - 1];
+}
+
+int bl_fade_init(void)
+{
+    int ret = pinctrl_apply_state(PINCTRL_DT_DEV_CONFIG_GET(BL_PWM_NODE), PINCTRL_STATE_DEFAULT);
+    if (ret) {
+        LOG_ERR("pinctrl apply failed: %d", ret);
+        return ret;
+    }
+
+    nrfx_pwm_config_t cfg = NRFX_PWM_DEFAULT_CONFIG(NRF_PWM_PIN_NOT_CONNECTED,
+                                                    NRF_PWM_PIN_NOT_CONNECTED,
+                                                    NRF_PWM_PIN_NOT_CONNECTED,
+                                                    NRF_PWM_PIN_NOT_CONNECTED);
+    cfg.skip_gpio_cfg = true;          /* 引脚与 PSEL 都由 pinctrl 配好 */
+    cfg.skip_psel_cfg = true;
+    cfg.base_clock    = NRF_PWM_CLK_16MHz;
+    cfg.count_mode    = NRF_PWM_MODE_UP;
+    cfg.top_value     = BL_TOP;
+    cfg.load_mode     = NRF_PWM_LOAD_COMMON;
+    cfg.step_mode     = NRF_PWM_STEP_AUTO;
+
+    /* handler=NULL：驱动不开 PWM 中断，回放全程无 CPU 唤醒 */
+    nrfx_err_t err = nrfx_pwm_init(&s_pwm, &cfg, NULL, NULL);
+    if (err != NRFX_SUCCESS) {
+        LOG_ERR("nrfx_pwm_init failed: 0x%08x", err);
+        return -EIO;
+    }
+
+    s_ready = true;
+    LOG_INF("bl_fade ready: top=%u (%u us period)", BL_TOP, BL_PERIOD_US);
+    return 0;
+}
+
+void bl_fade_to(uint8_t pct, uint32_t ms)
+{
+    if (!s_ready) return;
+    pct = MIN(pct, 100);
+
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+
+    int64_t now  = k_uptime_get();
+    uint8_t from = level_at(now);
+    uint16_t *buf = next_buf();
+    uint32_t rep;
+    uint16_t n = build_ramp(buf, from, pct, ms, &rep);
+
+    nrf_pwm_sequence_t seq = {
+        .values.p_common = buf,
+        .length          = n,
+        .repeats         = rep,
+        .end_delay       = 0,
+    };
+
+    s_tl.t0 = now;
+    s_tl.n  = 2;
+    s_tl.t[0] = 0;  s_tl.v[0] = from;
+    s_tl.t[1] = ms; s_tl.v[1] = pct;
+
+    /* 播完保持最后一个值；目标为 0 时播完直接 STOP，外设停下不再耗电 */
+    (void)nrfx_pwm_simple_playback(&s_pwm, &seq, 1, (pct == 0) ? NRFX_PWM_FLAG_STOP : 0);
+
+    k_spin_unlock(&s_lock, key);
+}
+
+uint32_t bl_fade_dim_then_off(uint8_t dim_pct, uint32_t fade_ms, uint32_t hold_ms)
+{
+    if (!s_ready) return 0;
+
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+
+    int64_t now  = k_uptime_get();
+    uint8_t from = level_at(now);
+    uint8_t dim  = MIN(dim_pct, from);
+    uint32_t rep0, rep1;
+
+    uint16_t *b0 = next_buf();
+    uint16_t *b1 = next_buf();
+    uint16_t n0 = build_ramp(b0, from, dim, fade_ms, &rep0);
+    uint16_t n1 = build_ramp(b1, dim, 0, fade_ms, &rep1);
+
+    /* 第一段末尾用 ENDDELAY 保持在暗亮度，第二段播完 LOOPSDONE→STOP */
+    nrf_pwm_sequence_t seq0 = {
+        .values.p_common = b0,
+        .length          = n0,
+        .repeats         = rep0,
+        .end_delay       = MIN((uint32_t)((uint64_t)hold_ms * 1000U / BL_PERIOD_US), BL_SEQ_MAX),
+    };
+    nrf_pwm_sequence_t seq1 = {
+        .values.p_common = b1,
+        .length          = n1,
+        .repeats         = rep1,
+        .end_delay       = 0,
+    };
+
+    s_tl.t0 = now;
+    s_tl.n  = 4;
+    s_tl.t[0] = 0;                          s_tl.v[0] = from;
+    s_tl.t[1] = fade_ms;                    s_tl.v[1] = dim;
+    s_tl.t[2] = fade_ms + hold_ms;          s_tl.v[2] = dim;
+    s_tl.t[3] = fade_ms * 2U + hold_ms;     s_tl.v[3] = 0;
+
+    (void)nrfx_pwm_complex_playback(&s_pwm, &seq0, &seq1, 1, NRFX_PWM_FLAG_STOP);
+
+    k_spin_unlock(&s_lock, key);
+    return fade_ms * 2U + hold_ms;
+}
+
+uint8_t bl_fade_level(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    uint8_t v = level_at(k_uptime_get());
+    k_spin_unlock(&s_lock, key);
+    return v;
+}
@@ -0,0 +1,44 @@
+#ifndef BL_FADE_H_
+#define BL_FADE_H_
+
+/**
+ * @file bl_fade.h
+ * @brief 背光渐变引擎：nRF PWM + EasyDMA 序列回放
+ *
+ * 渐变曲线预先算成（gamma 校正后的）占空比数组放在 RAM 里，交给 PWM 外设
+ * 用 EasyDMA 自己逐点回放：整个渐变过程 CPU 不参与、不开中断、不占 work 队列。
+ *  - 序列播完后 PWM 保持最后一个值，即停在目标亮度
+ *  - 渐变到 0 时用 LOOPSDONE→STOP 短接，播完直接停外设，引脚回到空闲低电平
+ *
+ * 依赖：
+ *  - Devicetree: aliases { backlight = ...; } 指向 pwms = <&pwm0 0 ...> 的节点，
+ *    且 &pwm0 status = "disabled"（不让 Zephyr 的 PWM 驱动占用该实例）
+ *  - Kconfig: CONFIG_NRFX_PWM0=y
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 初始化 PWM 实例与引脚，初始输出 0 */
+int      bl_fade_init(void);
+
+/** 从当前亮度渐变到 pct（0~100，感知亮度），用时 ms；ms=0 立即生效 */
+void     bl_fade_to(uint8_t pct, uint32_t ms);
+
+/**
+ * 先在 fade_ms 内降到 dim_pct，保持 hold_ms，再在 fade_ms 内降到 0 并停止 PWM。
+ * 两段由同一次 DMA 回放完成。返回整个过程的时长（ms），供调用方安排 display blank。
+ */
+uint32_t bl_fade_dim_then_off(uint8_t dim_pct, uint32_t fade_ms, uint32_t hold_ms);
+
+/** 估算当前输出亮度（0~100）：按回放起始时间插值，不读硬件 */
+uint8_t  bl_fade_level(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BL_FADE_H_ */
@@ -0,0 +1,210 @@
+// bl_schedule.c
+#include "bl_schedule.h"
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/posix/time.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+#include <string.h>
+#if IS_ENABLED(CONFIG_SETTINGS)
+#include <zephyr/settings/settings.h>
+#endif
+
+#include "backlight_ctrl.h"
+#include "settings_cache.h"
+#include "ble/time_bus.h"
+
+LOG_MODULE_REGISTER(bl_sched, LOG_LEVEL_INF);
+
+struct bl_sched_cfg {
+    uint8_t enabled;
+    uint8_t pct[BL_SCHED_HOURS];
+};
+
+static struct k_spinlock s_lock;
+static struct bl_sched_cfg s_cfg = {
+    .enabled = 1,
+    .pct = {
+        /* 00-05 */  20,  20,  20,  20,  20,  20,
+        /* 06-11 */  50,  80, 100, 100, 100, 100,
+        /* 12-17 */ 100, 100, 100, 100, 100, 100,
+        /* 18-23 */  90,  80,  60,  50,  35,  25,
+    },
+};
+
+static atomic_t s_scale = ATOMIC_INIT(100);   /* 最近一次求值的系数 */
+static atomic_t s_hour  = ATOMIC_INIT(-1);    /* 对应的小时；-1=时钟未设置 */
+
+static void hour_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(s_hour_work, hour_work_handler);
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+/* settings: /blsched/cfg */
+static int blsched_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+                                void *cb_arg)
+{
+    if (!strcmp(name, "cfg") && len == sizeof(struct bl_sched_cfg)) {
+        struct bl_sched_cfg c;
+        if (read_cb(cb_arg, &c, sizeof(c)) != sizeof(c)) return -EIO;
+        settings_cache_seed("blsched/cfg", &c, sizeof(c));
+        for (size_t i = 0; i < BL_SCHED_HOURS; i++) {
+            c.pct[i] = MIN(c.pct[i], 100);
+        }
+        c.enabled = !!c.enabled;
+
+        k_spinlock_key_t key = k_spin_lock(&s_lock);
+        s_cfg = c;
+        k_spin_unlock(&s_lock, key);
+        return 0;
+    }
+    return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(blsched, "blsched", NULL, blsched_settings_set, NULL, NULL);
+
+static inline void blsched_save(const struct bl_sched_cfg *c)
+{
+    (void)settings_cache_put("blsched/cfg", c, sizeof(*c));
+}
+#else
+static inline void blsched_save(const struct bl_sched_cfg *c) { ARG_UNUSED(c); }
+#endif
+
+/* 本地时间的小时与距下一个整点的秒数；时钟未设置返回 false */
+static bool read_hour(int *hour, uint32_t *to_next_s)
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_REALTIME, &ts) != 0 || ts.tv_sec < BL_SCHED_EPOCH_MIN) {
+        return false;
+    }
+
+    struct tm tm_local;
+    if (!localtime_r(&ts.tv_sec, &tm_local)) return false;
+
+    *hour      = tm_local.tm_hour;
+    *to_next_s = 3600U - (uint32_t)(tm_local.tm_min * 60 + tm_local.tm_sec);
+    return true;
+}
+
+uint8_t bl_schedule_eval(void)
+{
+    int hour;
+    uint32_t to_next_s;
+    uint8_t scale = 100;
+
+    if (!read_hour(&hour, &to_next_s)) {
+        /* 没对时就不知道现在是白天还是夜里：按原亮度，等 time_chan */
+        atomic_set(&s_hour, -1);
+        atomic_set(&s_scale, scale);
+        (void)k_work_cancel_delayable(&s_hour_work);
+        return scale;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    if (s_cfg.enabled) scale = s_cfg.pct[hour];
+    k_spin_unlock(&s_lock, key);
+
+    atomic_set(&s_hour, hour);
+    atomic_set(&s_scale, scale);
+
+    /* 多等 1s，落在整点之后，避免 RTC 抖动算回上一个小时 */
+    (void)k_work_reschedule(&s_hour_work, K_SECONDS(to_next_s + 1U));
+    return scale;
+}
+
+static void hour_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    /* 屏不亮就不续排：下次亮屏时 do_wake 会重新求值 */
+    if (!blctl_is_awake()) {
+        return;
+    }
+
+    uint8_t old = (uint8_t)atomic_get(&s_scale);
+    uint8_t now = bl_schedule_eval();
+    if (now != old) {
+        LOG_INF("hour %ld: scale %u%% -> %u%%", (long)atomic_get(&s_hour), old, now);
+        blctl_refresh_brightness();
+    }
+}
+
+uint8_t bl_schedule_apply(uint8_t user_pct)
+{
+    if (user_pct == 0) return 0;
+
+    uint32_t v = ((uint32_t)user_pct * (uint32_t)atomic_get(&s_scale) + 50U) / 100U;
+    return (uint8_t)CLAMP(v, MIN(BL_SCHED_MIN_PCT, user_pct), 100U);
+}
+
+/* 配置变化：亮屏时立刻按新表重算并输出，熄屏时留给下次亮屏 */
+static void cfg_changed(void)
+{
+    if (blctl_is_awake()) {
+        (void)bl_schedule_eval();
+        blctl_refresh_brightness();
+    }
+}
+
+int bl_schedule_set(uint8_t first_hour, const uint8_t *pct, uint8_t count)
+{
+    if (!pct || count == 0 || first_hour >= BL_SCHED_HOURS ||
+        count > BL_SCHED_HOURS - first_hour) {
+        return -EINVAL;
+    }
+
+    struct bl_sched_cfg c;
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    for (uint8_t i = 0; i < count; i++) {
+        s_cfg.pct[first_hour + i] = MIN(pct[i], 100);
+    }
+    c = s_cfg;
+    k_spin_unlock(&s_lock, key);
+
+    blsched_save(&c);
+    cfg_changed();
+    return 0;
+}
+
+void bl_schedule_get(uint8_t out[BL_SCHED_HOURS])
+{
+    if (!out) return;
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    memcpy(out, s_cfg.pct, BL_SCHED_HOURS);
+    k_spin_unlock(&s_lock, key);
+}
+
+int bl_schedule_set_enabled(bool en)
+{
+    struct bl_sched_cfg c;
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    s_cfg.enabled = en ? 1 : 0;
+    c = s_cfg;
+    k_spin_unlock(&s_lock, key);
+
+    blsched_save(&c);
+    cfg_changed();
+    LOG_INF("schedule %s", en ? "on" : "off");
+    return 0;
+}
+
+bool bl_schedule_is_enabled(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    bool en = s_cfg.enabled;
+    k_spin_unlock(&s_lock, key);
+    return en;
+}
+
+/* ==== 对时：时钟由 time_bus 的 listener 设置，这里只把重算排到工作队列，
+ * 届时 CLOCK_REALTIME 已经更新 ==== */
+static void blsched_time_cb(const struct zbus_channel *chan)
+{
+    ARG_UNUSED(chan);
+    if (blctl_is_awake()) {
+        (void)k_work_reschedule(&s_hour_work, K_NO_WAIT);
+    }
+}
+ZBUS_LISTENER_DEFINE(blsched_time_listener, blsched_time_cb);
+ZBUS_CHAN_ADD_OBS(time_chan, blsched_time_listener, 3);
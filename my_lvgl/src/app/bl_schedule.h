@@ -0,0 +1,56 @@
+#ifndef BL_SCHEDULE_H_
+#define BL_SCHEDULE_H_
+
+/**
+ * @file bl_schedule.h
+ * @brief 按时段调整背光：24 小时亮度系数表（夜间模式）
+ *
+ * 每个整点一个系数（0~100%），实际亮度 = 用户亮度 × 当前小时系数。
+ * 缺省表白天 100%，傍晚逐级降低，深夜 20%。
+ *
+ * 只在两种时刻求值，从不轮询：
+ *  - 亮屏时（backlight_ctrl 的 do_wake 调 bl_schedule_eval()）
+ *  - 亮屏期间跨整点（单次定时器排到下一个整点；熄屏后不再续排）
+ * 时钟未设置（CLOCK_REALTIME 早于 BL_SCHED_EPOCH_MIN）时系数视为 100%，
+ * 收到 time_chan 对时后立即重算一次。
+ *
+ * 配置持久化到 settings "blsched/cfg"，BLE 0x03 / 0x45 读写。
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BL_SCHED_HOURS     24
+
+#ifndef BL_SCHED_MIN_PCT
+#define BL_SCHED_MIN_PCT   5      /**< 换算后的下限：用户亮度非 0 时不至于黑到看不见 */
+#endif
+#ifndef BL_SCHED_EPOCH_MIN
+#define BL_SCHED_EPOCH_MIN 1577836800LL   /**< 2020-01-01：早于此视为时钟未设置 */
+#endif
+
+/** 按当前时间重算系数并排下一个整点；返回系数（0~100） */
+uint8_t bl_schedule_eval(void);
+
+/** 用最近一次求值的系数换算用户亮度（不读时钟，可在热路径调用） */
+uint8_t bl_schedule_apply(uint8_t user_pct);
+
+/** 改写 [first_hour, first_hour+count) 的系数；越界返回 -EINVAL */
+int     bl_schedule_set(uint8_t first_hour, const uint8_t *pct, uint8_t count);
+
+/** 读出整张表 */
+void    bl_schedule_get(uint8_t out[BL_SCHED_HOURS]);
+
+/** 关闭后系数恒为 100%（表保留） */
+int     bl_schedule_set_enabled(bool en);
+bool    bl_schedule_is_enabled(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BL_SCHEDULE_H_ */
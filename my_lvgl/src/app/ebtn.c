@@ -230,6 +230,25 @@ int ebtn_init(ebtn_btn_t *btns, uint16_t btns_cnt, ebtn_btn_combo_t *btns_combo,
     return 1;
 }
 
+/**
+ * \brief           Accumulate one button state into a local word and store it once per
+ *                  BIT_ARRAY_BITS buttons, instead of a read-modify-write of the array per button.
+ *
+ * \param[out]      state_array: all button state
+ * \param[in,out]   word: word being collected
+ * \param[in]       idx: Button internal key_idx
+ * \param[in]       state: Button state
+ */
+static inline void prv_state_put(bit_array_t *state_array, bit_array_val_t *word, int idx, uint8_t state)
+{
+    *word |= (bit_array_val_t)(state != 0) << BIT_ARRAY_BIT_INDEX(idx);
+    if (BIT_ARRAY_BIT_INDEX(idx) == BIT_ARRAY_BITS - 1)
+    {
+        bit_array_set_word_at(state_array, BIT_ARRAY_BIT_WORD(idx), *word);
+        *word = 0;
+    }
+}
+
 /**
  * \brief           Get all button state with get_state_fn.
  *
@@ -239,24 +258,26 @@ static void ebtn_get_current_state(bit_array_t *state_array)
 {
     ebtn_t *ebtobj = &ebtn_default;
     ebtn_btn_dyn_t *target;
+    bit_array_val_t word = 0;
     int i;
 
     /* Process all buttons */
     for (i = 0; i < ebtobj->btns_cnt; ++i)
     {
         /* Get button state */
-        uint8_t new_state = ebtobj->get_state_fn(&ebtobj->btns[i]);
-        // save state
-        bit_array_assign(state_array, i, new_state);
+        prv_state_put(state_array, &word, i, ebtobj->get_state_fn(&ebtobj->btns[i]));
     }
 
     for (target = ebtobj->btn_dyn_head, i = ebtobj->btns_cnt; target; target = target->next, i++)
     {
         /* Get button state */
-        uint8_t new_state = ebtobj->get_state_fn(&target->btn);
+        prv_state_put(state_array, &word, i, ebtobj->get_state_fn(&target->btn));
+    }
 
-        // save state
-        bit_array_assign(state_array, i, new_state);
+    /* Partial top word */
+    if (BIT_ARRAY_BIT_INDEX(i) != 0)
+    {
+        bit_array_set_word_at(state_array, BIT_ARRAY_BIT_WORD(i), word);
     }
 }
 
@@ -285,17 +306,12 @@ static void ebtn_process_btn(ebtn_btn_t *btn, bit_array_t *old_state, bit_array_
  */
 static void ebtn_process_btn_combo(ebtn_btn_t *btn, bit_array_t *old_state, bit_array_t *curr_state, bit_array_t *comb_key, ebtn_time_t mstime)
 {
-    BIT_ARRAY_DEFINE(tmp_data, EBTN_MAX_KEYNUM) = {0};
-
-    if (bit_array_num_bits_set(comb_key, EBTN_MAX_KEYNUM) == 0)
+    if (!bit_array_any(comb_key, EBTN_MAX_KEYNUM))
     {
         return;
     }
-    bit_array_and(tmp_data, curr_state, comb_key, EBTN_MAX_KEYNUM);
-    uint8_t curr = bit_array_cmp(tmp_data, comb_key, EBTN_MAX_KEYNUM) == 0;
-
-    bit_array_and(tmp_data, old_state, comb_key, EBTN_MAX_KEYNUM);
-    uint8_t old = bit_array_cmp(tmp_data, comb_key, EBTN_MAX_KEYNUM) == 0;
+    uint8_t curr = bit_array_and_cmp_eq(curr_state, comb_key, EBTN_MAX_KEYNUM);
+    uint8_t old = bit_array_and_cmp_eq(old_state, comb_key, EBTN_MAX_KEYNUM);
 
     prv_process_btn(btn, old, curr, mstime);
 }
@@ -502,6 +518,124 @@ int ebtn_is_in_process(void)
     return 0;
 }
 
+/**
+ * \brief           Fold the next deadline of one button into `best`
+ *
+ * Mirrors the time checks in \ref prv_process_btn, using the state seen on the last process call.
+ *
+ * \param[in]       btn: Button instance
+ * \param[in]       state: Last processed input state of the button
+ * \param[in]       mstime: Time passed to the last process call
+ * \param[in,out]   best: Smallest remaining time so far, `-1` if none
+ */
+static void prv_btn_next_timeout(const ebtn_btn_t *btn, uint8_t state, ebtn_time_t mstime, ebtn_time_sign_t *best)
+{
+    const ebtn_btn_param_t *param = btn->param;
+    ebtn_time_sign_t t[2];
+    int n = 0;
+
+    if (param == NULL)
+    {
+        return;
+    }
+
+    if (state)
+    {
+        if (!(btn->flags & EBTN_FLAG_ONPRESS_SENT))
+        {
+            /* Press debounce */
+            t[n++] = ebtn_timer_sub(btn->time_state_change + param->time_debounce, mstime);
+        }
+        else
+        {
+            /* Next keepalive */
+            if (param->time_keepalive_period > 0)
+            {
+                t[n++] = ebtn_timer_sub(btn->keepalive_last_time + param->time_keepalive_period, mstime);
+            }
+            /* Scene1: multi click ending with a long press, strict `>` check */
+            if (btn->click_cnt > 0)
+            {
+                t[n++] = ebtn_timer_sub(btn->time_change + param->time_click_pressed_max + 1, mstime);
+            }
+        }
+    }
+    else
+    {
+        if (btn->flags & EBTN_FLAG_ONPRESS_SENT)
+        {
+            /* Release debounce */
+            t[n++] = ebtn_timer_sub(btn->time_state_change + param->time_debounce_release, mstime);
+        }
+        else if (btn->click_cnt > 0)
+        {
+            /* Multi click window closes */
+            t[n++] = ebtn_timer_sub(btn->click_last_time + param->time_click_multi_max, mstime);
+        }
+        else if (btn->flags & EBTN_FLAG_IN_PROCESS)
+        {
+            /* One more call clears the in-process flag */
+            t[n++] = 0;
+        }
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        ebtn_time_sign_t v = t[i] < 0 ? 0 : t[i];
+        if (*best < 0 || v < *best)
+        {
+            *best = v;
+        }
+    }
+}
+
+/**
+ * \brief           Get combo-button state from the all-button state array
+ *
+ * \param[in]       state: All button state
+ * \param[in]       comb_key: Combo key
+ * \return          `1` if all keys of the combo are active, `0` otherwise
+ */
+static uint8_t prv_combo_state(bit_array_t *state, bit_array_t *comb_key)
+{
+    if (!bit_array_any(comb_key, EBTN_MAX_KEYNUM))
+    {
+        return 0;
+    }
+    return bit_array_and_cmp_eq(state, comb_key, EBTN_MAX_KEYNUM);
+}
+
+ebtn_time_sign_t ebtn_get_next_timeout(ebtn_time_t mstime)
+{
+    ebtn_t *ebtobj = &ebtn_default;
+    ebtn_btn_dyn_t *target;
+    ebtn_btn_combo_dyn_t *target_combo;
+    ebtn_time_sign_t best = -1;
+    int i;
+
+    for (i = 0; i < ebtobj->btns_cnt; ++i)
+    {
+        prv_btn_next_timeout(&ebtobj->btns[i], bit_array_get(ebtobj->old_state, i), mstime, &best);
+    }
+
+    for (target = ebtobj->btn_dyn_head, i = ebtobj->btns_cnt; target; target = target->next, i++)
+    {
+        prv_btn_next_timeout(&target->btn, bit_array_get(ebtobj->old_state, i), mstime, &best);
+    }
+
+    for (i = 0; i < ebtobj->btns_combo_cnt; ++i)
+    {
+        prv_btn_next_timeout(&ebtobj->btns_combo[i].btn, prv_combo_state(ebtobj->old_state, ebtobj->btns_combo[i].comb_key), mstime, &best);
+    }
+
+    for (target_combo = ebtobj->btn_combo_dyn_head; target_combo; target_combo = target_combo->next)
+    {
+        prv_btn_next_timeout(&target_combo->btn.btn, prv_combo_state(ebtobj->old_state, target_combo->btn.comb_key), mstime, &best);
+    }
+
+    return best;
+}
+
 int ebtn_register(ebtn_btn_dyn_t *button)
 {
     ebtn_t *ebtobj = &ebtn_default;
@@ -331,6 +331,18 @@ int ebtn_is_btn_in_process(const ebtn_btn_t *btn);
  */
 int ebtn_is_in_process(void);
 
+/**
+ * \brief           Get time until the next state-machine deadline.
+ * Covers press/release debounce, click max, multi-click window and keepalive of every button and combo.
+ * Meant to be called right after \ref ebtn_process with the same time; the caller can sleep until the
+ * returned time or the next input edge, whichever comes first.
+ *
+ * \param[in]       mstime: Time passed to the last \ref ebtn_process call
+ * \return          Milliseconds until the next deadline (`0` = process again now),
+ *                  `-1` if no deadline is pending (only an input change can advance any button)
+ */
+ebtn_time_sign_t ebtn_get_next_timeout(ebtn_time_t mstime);
+
 /**
  * \brief           Initialize button manager
  * \param[in]       btns: Array of buttons to process
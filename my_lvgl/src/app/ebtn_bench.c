@@ -0,0 +1,196 @@
+// ebtn_bench.c — easy_button 自检与基准：开机跑一次后交还给 key_ebtn
+//  1) 脚本化时间线（ebtn_timeline.c，主机上也能跑：tests/ebtn）
+//  2) 按键数 8/16/32/64 下 ebtn_process 的单次开销
+//  3) 组合键判定内核：通用三步 vs 融合版
+// 编译：west build -- -DEBTN_BENCH=ON -DCONFIG_TIMING_FUNCTIONS=y
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/logging/log.h>
+
+#include "ebtn.h"
+#include "ebtn_timeline.h"
+#include "bit_array.h"
+
+LOG_MODULE_REGISTER(ebtn_bench, LOG_LEVEL_INF);
+
+#if !IS_ENABLED(CONFIG_TIMING_FUNCTIONS)
+#error "EBTN_BENCH needs CONFIG_TIMING_FUNCTIONS=y (DWT cycle counter)"
+#endif
+
+#ifndef EBTN_BENCH_COMBOS
+#define EBTN_BENCH_COMBOS  48
+#endif
+#ifndef EBTN_BENCH_ROUNDS
+#define EBTN_BENCH_ROUNDS  2000      /* 每档 ebtn_process 调用次数，模拟时间步长 5ms */
+#endif
+#define EBTN_BENCH_STEP_MS 5
+
+/* 去抖 20/20，点击 20~300，多击间隔 200，keepalive 500，最多 10 连击 */
+static const ebtn_btn_param_t s_param = EBTN_PARAMS_INIT(20, 20, 20, 300, 200, 500, 10);
+
+static ebtn_btn_t       s_btns[EBTN_MAX_KEYNUM];
+static ebtn_btn_combo_t s_combos[EBTN_BENCH_COMBOS];
+
+/* 模拟输入：一个位图，key_id 即位号 */
+static BIT_ARRAY_DEFINE(s_input, EBTN_MAX_KEYNUM);
+static uint32_t s_rng;
+static uint32_t s_evt_cnt[4];
+
+static uint32_t rng(void)
+{
+    /* xorshift32：固定种子，前后两次提交跑出的事件序列相同，可直接对比事件计数 */
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static uint8_t bench_get_state(struct ebtn_btn *btn)
+{
+    return (uint8_t)bit_array_get(s_input, btn->key_id);
+}
+
+/* ==================== 1) 脚本化时间线 ==================== */
+
+static void bench_timelines(void)
+{
+    int total;
+    int pass = ebtn_timeline_run_all(printk, &total);
+
+    if (pass == total) {
+        LOG_INF("timelines: %d/%d passed", pass, total);
+    } else {
+        LOG_ERR("timelines: %d/%d passed", pass, total);
+    }
+}
+
+/* ==================== 2) 随机负载下的单次开销 ==================== */
+
+static void bench_evt(struct ebtn_btn *btn, ebtn_evt_t evt)
+{
+    ARG_UNUSED(btn);
+    s_evt_cnt[evt]++;
+}
+
+static void bench_setup(int keys, int combos)
+{
+    s_rng = 0x1234567u;
+    for (int i = 0; i < keys; i++) {
+        s_btns[i] = (ebtn_btn_t)EBTN_BUTTON_INIT(i, &s_param);
+    }
+    for (int c = 0; c < combos; c++) {
+        s_combos[c] = (ebtn_btn_combo_t)EBTN_BUTTON_COMBO_INIT(0x100 + c, &s_param);
+        /* 2~4 键组合；64 键时键位跨两个字，覆盖多字路径 */
+        int n = 2 + (int)(rng() % 3U);
+        for (int k = 0; k < n; k++) {
+            ebtn_combo_btn_add_btn_by_idx(&s_combos[c], (int)(rng() % (uint32_t)keys));
+        }
+    }
+    bit_array_clear_all(s_input, EBTN_MAX_KEYNUM);
+    memset(s_evt_cnt, 0, sizeof(s_evt_cnt));
+    (void)ebtn_init(s_btns, keys, s_combos, combos, bench_get_state, bench_evt);
+}
+
+/* 输入脚本：每 40ms 随机翻转一个键，每 400ms 按下/松开一个组合 */
+static void bench_drive(uint32_t round, int keys, int combos)
+{
+    if ((round % 8U) == 0) {
+        bit_array_toggle(s_input, (int)(rng() % (uint32_t)keys));
+    }
+    if ((round % 80U) == 0) {
+        ebtn_btn_combo_t *c = &s_combos[rng() % (uint32_t)combos];
+        bit_array_or(s_input, s_input, c->comb_key, EBTN_MAX_KEYNUM);
+    } else if ((round % 80U) == 40U) {
+        bit_array_clear_all(s_input, EBTN_MAX_KEYNUM);
+    }
+}
+
+static void bench_scaling(void)
+{
+    static const int key_counts[] = { 8, 16, 32, EBTN_MAX_KEYNUM };
+
+    for (size_t k = 0; k < ARRAY_SIZE(key_counts); k++) {
+        int keys   = key_counts[k];
+        int combos = MIN(keys * 3 / 4, EBTN_BENCH_COMBOS);
+        uint64_t proc = 0, dl = 0;
+        ebtn_time_t now = 0;
+
+        bench_setup(keys, combos);
+        for (uint32_t r = 0; r < EBTN_BENCH_ROUNDS; r++) {
+            bench_drive(r, keys, combos);
+            now += EBTN_BENCH_STEP_MS;
+
+            timing_t a = timing_counter_get();
+            ebtn_process(now);
+            timing_t b = timing_counter_get();
+            (void)ebtn_get_next_timeout(now);
+            timing_t c = timing_counter_get();
+
+            proc += timing_cycles_get(&a, &b);
+            dl   += timing_cycles_get(&b, &c);
+        }
+
+        LOG_INF("%2d keys %2d combos: process %u cyc (%u ns), next_timeout %u cyc",
+                keys, combos,
+                (uint32_t)(proc / EBTN_BENCH_ROUNDS),
+                (uint32_t)(timing_cycles_to_ns(proc) / EBTN_BENCH_ROUNDS),
+                (uint32_t)(dl / EBTN_BENCH_ROUNDS));
+        LOG_INF("  events: press=%u release=%u click=%u keepalive=%u",
+                s_evt_cnt[EBTN_EVT_ONPRESS], s_evt_cnt[EBTN_EVT_ONRELEASE],
+                s_evt_cnt[EBTN_EVT_ONCLICK], s_evt_cnt[EBTN_EVT_KEEPALIVE]);
+    }
+}
+
+/* ==================== 3) 组合键判定内核 ==================== */
+
+/* 原三步（popcount + and 到临时数组 + memcmp）对比融合版；沿用最后一档的组合键 */
+static void bench_kernels(void)
+{
+    volatile uint32_t sink = 0;
+    timing_t t0, t1;
+
+    t0 = timing_counter_get();
+    for (int r = 0; r < 1000; r++) {
+        for (int c = 0; c < EBTN_BENCH_COMBOS; c++) {
+            BIT_ARRAY_DEFINE(tmp, EBTN_MAX_KEYNUM) = {0};
+            if (bit_array_num_bits_set(s_combos[c].comb_key, EBTN_MAX_KEYNUM) == 0) continue;
+            bit_array_and(tmp, s_input, s_combos[c].comb_key, EBTN_MAX_KEYNUM);
+            sink += bit_array_cmp(tmp, s_combos[c].comb_key, EBTN_MAX_KEYNUM) == 0;
+        }
+    }
+    t1 = timing_counter_get();
+    uint64_t generic = timing_cycles_get(&t0, &t1);
+
+    t0 = timing_counter_get();
+    for (int r = 0; r < 1000; r++) {
+        for (int c = 0; c < EBTN_BENCH_COMBOS; c++) {
+            if (!bit_array_any(s_combos[c].comb_key, EBTN_MAX_KEYNUM)) continue;
+            sink += bit_array_and_cmp_eq(s_input, s_combos[c].comb_key, EBTN_MAX_KEYNUM);
+        }
+    }
+    t1 = timing_counter_get();
+    uint64_t fused = timing_cycles_get(&t0, &t1);
+
+    uint32_t n = 1000U * EBTN_BENCH_COMBOS;
+    LOG_INF("combo kernel: generic %u cyc, fused %u cyc per combo (sink=%u)",
+            (uint32_t)(generic / n), (uint32_t)(fused / n), sink);
+}
+
+static int ebtn_bench_run(void)
+{
+    timing_init();
+    timing_start();
+
+    bench_timelines();
+    bench_scaling();
+    bench_kernels();
+
+    timing_stop();
+    /* 之后 key_ebtn_thread_init() 会用自己的按键重新 ebtn_init */
+    return 0;
+}
+
+/* main() 之前跑完，不与 key_ebtn 线程共用 ebtn 的全局实例 */
+SYS_INIT(ebtn_bench_run, APPLICATION, 90);
@@ -0,0 +1,210 @@
+// ebtn_timeline.c — easy_button 脚本化时间线自检，不依赖 Zephyr
+//  用虚拟时钟驱动 ebtn_process_with_curr_state，逐条比对事件序列与时间戳；
+//  每条时间线再按“只在边沿/截止时间调用”与“时钟回绕”各跑一遍，结果必须一致。
+//  板上由 ebtn_bench.c 调用，主机上由 tests/ebtn 的 ctest 调用
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "ebtn_timeline.h"
+#include "ebtn.h"
+#include "bit_array.h"
+
+#define EBTN_TL_MAX_EVT 16           /* 单条时间线最多记录的事件数 */
+
+/* 去抖 20/20，点击 20~300，多击间隔 200，keepalive 500，最多 10 连击 */
+static const ebtn_btn_param_t s_param = EBTN_PARAMS_INIT(20, 20, 20, 300, 200, 500, 10);
+
+/* 模拟输入：一个位图，key_id 即位号 */
+static BIT_ARRAY_DEFINE(s_input, EBTN_MAX_KEYNUM);
+static ebtn_tl_print_t s_print;
+
+static uint8_t tl_get_state(struct ebtn_btn *btn)
+{
+    return (uint8_t)bit_array_get(s_input, btn->key_id);
+}
+
+#define K(n)        ((uint64_t)1 << (n))
+#define COMBO_ID    0x100          /* 时间线里唯一的组合键：键 1 + 键 2 */
+
+struct tl_step {
+    uint32_t t;                    /* 相对时间线起点的 ms */
+    uint64_t keys;                 /* 此刻起的输入位图 */
+};
+
+struct tl_evt {
+    uint16_t key_id;
+    uint8_t  evt;                  /* ebtn_evt_t */
+    uint8_t  cnt;                  /* ONCLICK: click_cnt；KEEPALIVE: keepalive_cnt；其余 0 */
+    uint32_t t;                    /* 相对时间线起点的 ms */
+};
+
+struct tl_case {
+    const char           *name;
+    const struct tl_step *steps;
+    uint8_t               n_steps;
+    uint32_t              end;     /* 跑到这个时刻为止 */
+    const struct tl_evt  *expect;
+    uint8_t               n_expect;
+};
+
+#define P_(k, t)      { (k), EBTN_EVT_ONPRESS,   0,   (t) }
+#define R_(k, t)      { (k), EBTN_EVT_ONRELEASE, 0,   (t) }
+#define C_(k, t, n)   { (k), EBTN_EVT_ONCLICK,   (n), (t) }
+#define KA(k, t, n)   { (k), EBTN_EVT_KEEPALIVE, (n), (t) }
+
+/* 按下 10ms 时抖了一下：去抖从最后一次变化（15ms）重新算 */
+static const struct tl_step s_bounce_in[] = { {10, K(0)}, {13, 0}, {15, K(0)}, {120, 0} };
+static const struct tl_evt  s_bounce_ex[] = { P_(0, 35), R_(0, 140), C_(0, 340, 1) };
+
+/* 双击：第二次松开后等多击窗口关闭才报 2 */
+static const struct tl_step s_dbl_in[] = { {10, K(0)}, {110, 0}, {200, K(0)}, {300, 0} };
+static const struct tl_evt  s_dbl_ex[] = { P_(0, 30), R_(0, 130), P_(0, 220), R_(0, 320), C_(0, 520, 2) };
+
+/* 长按：每 500ms 一次 keepalive，超过点击上限松开不算点击 */
+static const struct tl_step s_long_in[] = { {10, K(0)}, {1300, 0} };
+static const struct tl_evt  s_long_ex[] = { P_(0, 30), KA(0, 530, 1), KA(0, 1030, 2), R_(0, 1320) };
+
+/* 单击后接长按：按住超过点击上限（严格大于 300）时先结算前面的单击 */
+static const struct tl_step s_clk_long_in[] = { {10, K(0)}, {110, 0}, {200, K(0)}, {1000, 0} };
+static const struct tl_evt  s_clk_long_ex[] = {
+    P_(0, 30), R_(0, 130), P_(0, 220), C_(0, 521, 1), KA(0, 720, 1), R_(0, 1020),
+};
+
+/* 组合键：单键先于组合处理，同一时刻按 键1、键2、组合 的顺序 */
+static const struct tl_step s_combo_in[] = { {10, K(1)}, {15, K(1) | K(2)}, {200, 0} };
+static const struct tl_evt  s_combo_ex[] = {
+    P_(1, 30), P_(2, 35), P_(COMBO_ID, 35),
+    R_(1, 220), R_(2, 220), R_(COMBO_ID, 220),
+    C_(1, 420, 1), C_(2, 420, 1), C_(COMBO_ID, 420, 1),
+};
+
+#define TL_CASE(_name, _in, _ex, _end) \
+    { _name, _in, EBTN_ARRAY_SIZE(_in), _end, _ex, EBTN_ARRAY_SIZE(_ex) }
+
+static const struct tl_case s_cases[] = {
+    TL_CASE("bounce",     s_bounce_in,   s_bounce_ex,   800),
+    TL_CASE("double",     s_dbl_in,      s_dbl_ex,      800),
+    TL_CASE("long",       s_long_in,     s_long_ex,     1600),
+    TL_CASE("click+long", s_clk_long_in, s_clk_long_ex, 1400),
+    TL_CASE("combo",      s_combo_in,    s_combo_ex,    800),
+};
+
+static struct tl_evt s_log[EBTN_TL_MAX_EVT];
+static uint8_t       s_log_n;
+static bool          s_log_overflow;
+static ebtn_time_t   s_base;       /* 时间线起点（回绕测试时靠近 UINT32_MAX） */
+static ebtn_time_t   s_now;
+
+static void tl_evt_cb(struct ebtn_btn *btn, ebtn_evt_t evt)
+{
+    if (s_log_n >= EBTN_TL_MAX_EVT) {
+        s_log_overflow = true;
+        return;
+    }
+    struct tl_evt *e = &s_log[s_log_n++];
+    e->key_id = btn->key_id;
+    e->evt    = (uint8_t)evt;
+    e->cnt    = (evt == EBTN_EVT_ONCLICK)   ? (uint8_t)btn->click_cnt :
+                (evt == EBTN_EVT_KEEPALIVE) ? (uint8_t)btn->keepalive_cnt : 0;
+    e->t      = (uint32_t)(ebtn_time_t)(s_now - s_base);
+}
+
+static void tl_setup(void)
+{
+    static ebtn_btn_t       btns[3];
+    static ebtn_btn_combo_t combo;
+
+    for (int i = 0; i < 3; i++) {
+        btns[i] = (ebtn_btn_t)EBTN_BUTTON_INIT(i, &s_param);
+    }
+    combo = (ebtn_btn_combo_t)EBTN_BUTTON_COMBO_INIT(COMBO_ID, &s_param);
+    (void)ebtn_init(btns, 3, &combo, 1, tl_get_state, tl_evt_cb);
+    ebtn_combo_btn_add_btn_by_idx(&combo, 1);
+    ebtn_combo_btn_add_btn_by_idx(&combo, 2);
+
+    s_log_n = 0;
+    s_log_overflow = false;
+}
+
+static void tl_input(uint64_t keys)
+{
+    bit_array_clear_all(s_input, EBTN_MAX_KEYNUM);
+    for (int w = 0; w < BIT_ARRAY_BITMAP_SIZE(EBTN_MAX_KEYNUM); w++) {
+        bit_array_set_word_at(s_input, w, (bit_array_val_t)(keys >> (w * BIT_ARRAY_BITS)));
+    }
+}
+
+/* deadline=false：每 1ms 调一次（参考行为）；
+ * deadline=true ：只在输入变化和 ebtn_get_next_timeout 给出的时刻调用（key_ebtn 的方式） */
+static void tl_run(const struct tl_case *c, ebtn_time_t base, bool deadline)
+{
+    uint8_t step = 0;
+    int64_t next = -1;
+
+    tl_setup();
+    s_base = base;
+    tl_input(0);
+
+    for (uint32_t t = 0; t <= c->end; t++) {
+        bool edge = false;
+        while (step < c->n_steps && c->steps[step].t == t) {
+            tl_input(c->steps[step].keys);
+            step++;
+            edge = true;
+        }
+        if (deadline && !edge && (next < 0 || (int64_t)t < next)) {
+            continue;
+        }
+
+        s_now = base + t;
+        ebtn_process_with_curr_state(s_input, s_now);
+
+        ebtn_time_sign_t w = ebtn_get_next_timeout(s_now);
+        next = (w < 0) ? -1 : (int64_t)t + w;
+    }
+}
+
+static bool tl_check(const struct tl_case *c, const char *mode)
+{
+    bool ok = !s_log_overflow && s_log_n == c->n_expect &&
+              !memcmp(s_log, c->expect, sizeof(s_log[0]) * s_log_n);
+    if (ok) return true;
+
+    s_print("%s [%s]: got %u events, want %u\n", c->name, mode, s_log_n, c->n_expect);
+    for (uint8_t i = 0; i < EBTN_TL_MAX_EVT && (i < s_log_n || i < c->n_expect); i++) {
+        const struct tl_evt *g = (i < s_log_n)     ? &s_log[i]     : NULL;
+        const struct tl_evt *e = (i < c->n_expect) ? &c->expect[i] : NULL;
+        s_print("  #%u got %03x/%u/%u@%u want %03x/%u/%u@%u\n", i,
+                g ? g->key_id : 0, g ? g->evt : 0, g ? g->cnt : 0, g ? g->t : 0,
+                e ? e->key_id : 0, e ? e->evt : 0, e ? e->cnt : 0, e ? e->t : 0);
+    }
+    return false;
+}
+
+int ebtn_timeline_run_all(ebtn_tl_print_t print, int *total)
+{
+    static const struct {
+        const char *name;
+        ebtn_time_t base;
+        bool        deadline;
+    } modes[] = {
+        { "poll",          0,                           false },
+        { "deadline",      0,                           true  },
+        { "poll+wrap",     (ebtn_time_t)0 - 700U,       false },
+        { "deadline+wrap", (ebtn_time_t)0 - 700U,       true  },
+    };
+    int pass = 0, n = 0;
+
+    s_print = print;
+    for (size_t i = 0; i < EBTN_ARRAY_SIZE(s_cases); i++) {
+        for (size_t m = 0; m < EBTN_ARRAY_SIZE(modes); m++) {
+            tl_run(&s_cases[i], modes[m].base, modes[m].deadline);
+            pass += tl_check(&s_cases[i], modes[m].name) ? 1 : 0;
+            n++;
+        }
+    }
+    if (total) *total = n;
+    return pass;
+}
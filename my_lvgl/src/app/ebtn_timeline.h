@@ -0,0 +1,25 @@
+#ifndef _EBTN_TIMELINE_H
+#define _EBTN_TIMELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 失败时逐条打印对比用；printk 的签名正好匹配 */
+typedef void (*ebtn_tl_print_t)(const char *fmt, ...);
+
+/**
+ * 跑全部脚本化时间线（抖动、双击、长按、单击接长按、组合键），
+ * 每条按 poll / deadline / poll+wrap / deadline+wrap 四种方式各一遍。
+ * 会用自己的按键调用 ebtn_init，跑完后调用方需重新 ebtn_init。
+ * @param print 失败时输出 got/want 对比，不能为 NULL
+ * @param total 输出总次数（可为 NULL）
+ * @return 通过的次数，等于 *total 即全部通过
+ */
+int ebtn_timeline_run_all(ebtn_tl_print_t print, int *total);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _EBTN_TIMELINE_H */
@@ -0,0 +1,39 @@
+#ifndef KEY_CMD_H_
+#define KEY_CMD_H_
+
+/**
+ * @file key_cmd.h
+ * @brief 按键手势 → 命令：key_ebtn 查表后发布到 key_cmd_chan
+ *
+ * 手势与命令的对应关系只在 key_ebtn.c 的常量表里；订阅者（背光、UI、BLE）
+ * 用 ZBUS_CHAN_ADD_OBS 挂 listener，listener 里只做置位/提交工作项，
+ * 真正的处理在各自的线程或工作队列上完成，不占按键线程。
+ */
+
+#include <stdint.h>
+#include <zephyr/zbus/zbus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum key_cmd {
+    KEY_CMD_NONE = 0,
+    KEY_CMD_WAKE,         /**< 亮屏 */
+    KEY_CMD_HOME,         /**< 亮屏并回到表盘 */
+    KEY_CMD_BLE_ADV,      /**< 重新开始（快速）广播，方便手机重连 */
+};
+
+struct key_cmd_msg {
+    uint8_t cmd;          /**< enum key_cmd */
+    uint8_t key_id;       /**< 触发的按键 */
+    uint8_t count;        /**< 点击次数 / keepalive 次数 */
+};
+
+ZBUS_CHAN_DECLARE(key_cmd_chan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KEY_CMD_H_ */
@@ -1,5 +1,5 @@
-// key_ebtn_thread.c — easy_button 线程轮询版（严格按 README 语义）
-// 依赖：ebtn.c/.h、bit_array.h；backlight_ctrl.h
+// key_ebtn_thread.c — easy_button 线程版：中断 + 截止时间驱动（严格按 README 语义）
+// 依赖：ebtn.c/.h、bit_array.h；命令经 key_cmd_chan 发布，不直接调用其他模块
 
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
@@ -9,7 +9,7 @@
 
 #include "key_ebtn.h"        // ← 宏配置与 init 原型
 #include "ebtn.h"            // easy_button
-#include "backlight_ctrl.h"  // blctl_is_awake(), blctl_wake()
+#include "key_cmd.h"         // key_cmd_chan
 
 LOG_MODULE_REGISTER(key_ebtn, LOG_LEVEL_INF);
 
@@ -19,6 +19,8 @@ LOG_MODULE_REGISTER(key_ebtn, LOG_LEVEL_INF);
 #error "sw0 alias 未定义：请在 overlay 把你的按键映射为 sw0"
 #endif
 static const struct gpio_dt_spec g_btn = GPIO_DT_SPEC_GET(SW0_NODE, gpios);
+static struct gpio_callback s_btn_cb;
+static K_SEM_DEFINE(s_key_sem, 0, 1);    /* 按键边沿 → 唤醒 key_thread */
 
 /* 2) ebtn 参数（来自头文件里的宏） */
 static const ebtn_btn_param_t s_param = EBTN_PARAMS_INIT(
@@ -47,52 +49,76 @@ static uint8_t prv_get_state(struct ebtn_btn *btn)
     return active ? (val == 1) : (val == 0);
 }
 
-/* 5) 事件回调：长按靠 KEEPALIVE 的 keepalive_cnt；单/双击靠 ONCLICK */
-static bool s_long_reported = false;
+/* 5) 手势 → 命令表：新增手势只加一行，回调本身不变
+ *  CLICK ：ONCLICK 且点击次数 == count
+ *  LONG  ：第 count 个 KEEPALIVE（count=1 即长按成立的那一刻，只触发一次）
+ *  REPEAT：按住期间每个 KEEPALIVE 都触发（count 忽略）
+ */
+enum key_gesture { KEY_GST_CLICK = 0, KEY_GST_LONG, KEY_GST_REPEAT };
+
+struct key_action {
+    uint16_t key_id;
+    uint8_t  gesture;   /* enum key_gesture */
+    uint8_t  count;
+    uint8_t  cmd;       /* enum key_cmd */
+};
+
+static const struct key_action s_actions[] = {
+    { KEY_ID_SW0, KEY_GST_CLICK, 1, KEY_CMD_WAKE    },
+    { KEY_ID_SW0, KEY_GST_CLICK, 2, KEY_CMD_HOME    },
+    { KEY_ID_SW0, KEY_GST_LONG,  1, KEY_CMD_BLE_ADV },
+};
 
+ZBUS_CHAN_DEFINE(key_cmd_chan, struct key_cmd_msg, NULL, NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(.cmd = KEY_CMD_NONE));
+
+static void prv_dispatch(const struct ebtn_btn *btn, uint8_t gesture, uint16_t count)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(s_actions); i++) {
+        const struct key_action *a = &s_actions[i];
+        if (a->key_id != btn->key_id || a->gesture != gesture) continue;
+        if (gesture != KEY_GST_REPEAT && a->count != count) continue;
+
+        const struct key_cmd_msg m = {
+            .cmd    = a->cmd,
+            .key_id = (uint8_t)btn->key_id,
+            .count  = (uint8_t)MIN(count, UINT8_MAX),
+        };
+        /* listener 只做置位/提交，K_NO_WAIT 不会让按键线程等 */
+        (void)zbus_chan_pub(&key_cmd_chan, &m, K_NO_WAIT);
+        LOG_DBG("key %u gesture %u x%u -> cmd %u", btn->key_id, gesture, count, a->cmd);
+    }
+}
+
+/* 事件回调：只查表，不含业务逻辑 */
 static void prv_evt(struct ebtn_btn *btn, ebtn_evt_t evt)
 {
     switch (evt) {
-    case EBTN_EVT_ONPRESS:
-        s_long_reported = false;
-        LOG_DBG("ONPRESS");
+    case EBTN_EVT_ONCLICK:
+        prv_dispatch(btn, KEY_GST_CLICK, btn->click_cnt);
         break;
-
     case EBTN_EVT_KEEPALIVE:
-        /* 第一帧 keepalive 视为长按成立（满足 keepalive 周期） */
-        if (!s_long_reported && btn->keepalive_cnt >= 1) {
-            s_long_reported = true;
-            LOG_INF("Long press (keepalive_cnt=%u)", (unsigned)btn->keepalive_cnt);
-        }
-        break;
-
-    case EBTN_EVT_ONRELEASE:
-        LOG_DBG("ONRELEASE");
-        /* 提示：若按住时长介于 CLICK_MAX_MS 与 KEEPALIVE_MS 之间，可能不产生任何事件 */
+        prv_dispatch(btn, KEY_GST_LONG, btn->keepalive_cnt);
+        prv_dispatch(btn, KEY_GST_REPEAT, btn->keepalive_cnt);
         break;
-
-    case EBTN_EVT_ONCLICK: {
-        uint16_t n = btn->click_cnt;   /* README：点击次数存在结构体里 */
-        if (n == 1) {
-            if (!blctl_is_awake()) {
-                LOG_INF("Single click -> wake");
-                blctl_wake();
-            } else {
-                LOG_INF("Single click (already awake)");
-            }
-        } else if (n == 2) {
-            LOG_INF("Double click");
-        } else {
-            LOG_INF("%u-click", (unsigned)n);
-        }
-        } break;
-
     default:
+        /* 提示：若按住时长介于 CLICK_MAX_MS 与 KEEPALIVE_MS 之间，可能不产生任何事件 */
         break;
     }
 }
 
-/* 6) 线程：每 KEY_POLL_MS 调一次 ebtn_process（传系统毫秒时钟） */
+/* 6) 边沿中断（双沿）：只负责叫醒线程，去抖/判定仍全部交给 ebtn */
+static void prv_btn_isr(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+    ARG_UNUSED(dev); ARG_UNUSED(cb); ARG_UNUSED(pins);
+    k_sem_give(&s_key_sem);
+}
+
+/* 7) 线程：每次 ebtn_process 后向 ebtn 要“下一个截止时间”（去抖结束、点击上限、
+ * 多击窗口关闭、下一次 keepalive），睡到该时刻或下一个边沿为止。
+ * ebtn 的所有判定都基于传入的时间戳，只在这些时刻调用即可得到完全相同的事件；
+ * 没有截止时间（空闲，或按住且无 keepalive）时只等边沿。 */
 K_THREAD_STACK_DEFINE(key_stack, KEY_THREAD_STACK);
 static struct k_thread key_thread_data;
 
@@ -100,12 +126,17 @@ static void key_thread(void *a, void *b, void *c)
 {
     ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
     for (;;) {
-        ebtn_process((ebtn_time_t)k_uptime_get_32());
-        k_msleep(KEY_POLL_MS);
+        ebtn_time_t now = (ebtn_time_t)k_uptime_get_32();
+        ebtn_process(now);
+
+        /* 计算与睡眠之间来的边沿留在信号量里，不会丢；K_MSEC 向上取整到 tick，
+         * 醒来时一定已到截止时间，不会提前醒一次空转 */
+        ebtn_time_sign_t wait = ebtn_get_next_timeout(now);
+        (void)k_sem_take(&s_key_sem, (wait < 0) ? K_FOREVER : K_MSEC(wait));
     }
 }
 
-/* 7) 对外初始化 */
+/* 8) 对外初始化 */
 int key_ebtn_thread_init(void)
 {
     if (!gpio_is_ready_dt(&g_btn)) {
@@ -115,6 +146,15 @@ int key_ebtn_thread_init(void)
     int ret = gpio_pin_configure_dt(&g_btn, GPIO_INPUT);
     if (ret) return ret;
 
+    gpio_init_callback(&s_btn_cb, prv_btn_isr, BIT(g_btn.pin));
+    ret = gpio_add_callback_dt(&g_btn, &s_btn_cb);
+    if (ret) return ret;
+    ret = gpio_pin_interrupt_configure_dt(&g_btn, GPIO_INT_EDGE_BOTH);
+    if (ret) {
+        LOG_ERR("sw0 irq config failed: %d", ret);
+        return ret;
+    }
+
     if (!ebtn_init(s_btns, EBTN_ARRAY_SIZE(s_btns),
                    NULL, 0,
                    prv_get_state, prv_evt)) {
@@ -128,8 +168,8 @@ int key_ebtn_thread_init(void)
     k_thread_name_set(&key_thread_data, "key_ebtn");
 
     /* 拆成两条日志，避免 cbprintf 变参打包限制 */
-    LOG_INF("key_ebtn ready: poll=%dms, deb(p/r)=%d/%d",
-            (int)KEY_POLL_MS, (int)KEY_DEBOUNCE_PRESS_MS, (int)KEY_DEBOUNCE_RELEASE_MS);
+    LOG_INF("key_ebtn ready: irq + deadline, deb(p/r)=%d/%d",
+            (int)KEY_DEBOUNCE_PRESS_MS, (int)KEY_DEBOUNCE_RELEASE_MS);
     LOG_INF("click=[%d..%d]ms, gap=%dms, keepalive=%dms",
             (int)KEY_CLICK_MIN_MS, (int)KEY_CLICK_MAX_MS,
             (int)KEY_MULTI_GAP_MS, (int)KEY_KEEPALIVE_MS);
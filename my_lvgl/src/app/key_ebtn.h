@@ -3,7 +3,7 @@
 
 /**
  * @file key_ebtn.h
- * @brief easy_button 线程轮询版按键处理的配置与对外接口
+ * @brief easy_button 按键处理（边沿中断 + 截止时间唤醒，无固定轮询）的配置与对外接口
  *
  * 使用说明：
  *  - 这些宏都有默认值；你可以在 CMake/编译命令用 -D 覆盖，
@@ -49,11 +49,6 @@ extern "C" {
 #define KEY_MAX_CONSEC            2
 #endif
 
-/* 轮询周期（线程每隔多少毫秒调用一次 ebtn_process） */
-#ifndef KEY_POLL_MS
-#define KEY_POLL_MS               5    /* 5–10ms 常用 */
-#endif
-
 /* 线程配置（可按需调小/调高栈或优先级） */
 #ifndef KEY_THREAD_STACK
 #define KEY_THREAD_STACK        1024
@@ -65,11 +60,11 @@ extern "C" {
 /* ================= 对外接口 ================= */
 
 /**
- * @brief 初始化并启动按键处理线程（无需中断）
+ * @brief 初始化并启动按键处理线程（sw0 双沿中断唤醒）
  * 依赖：
- *  - Devicetree: alias sw0 指向你的按键
+ *  - Devicetree: alias sw0 指向你的按键（nRF 上建议该引脚加入 sense-edge-mask）
  *  - easy_button 源码：ebtn.c / ebtn.h / bit_array.h
- *  - 你的背光模块：backlight_ctrl.h（提供 blctl_is_awake()/blctl_wake()）
+ *  - 手势对应的命令发布到 key_cmd_chan（key_cmd.h），由背光/UI/BLE 各自订阅
  */
 int key_ebtn_thread_init(void);
 
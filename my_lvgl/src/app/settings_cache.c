@@ -0,0 +1,174 @@
+// settings_cache.c
+#include "settings_cache.h"
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+#if IS_ENABLED(CONFIG_SETTINGS)
+#include <zephyr/settings/settings.h>
+#endif
+
+LOG_MODULE_REGISTER(settings_cache, LOG_LEVEL_INF);
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+
+struct cache_slot {
+    char    key[SETTINGS_CACHE_KEY_MAX];
+    uint8_t val[SETTINGS_CACHE_VAL_MAX];
+    uint8_t len;
+    bool    dirty;
+    /* 上次真正写进 flash 的值：改来改去又改回原值时不再写 */
+    uint8_t saved[SETTINGS_CACHE_VAL_MAX];
+    uint8_t saved_len;
+};
+
+static struct cache_slot s_slots[SETTINGS_CACHE_SLOTS];
+static K_MUTEX_DEFINE(s_lock);
+
+static void flush_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(s_flush_work, flush_work_handler);
+static uint32_t s_retry_ms;     /* 0 = 上次 flush 全部成功；只在系统工作队列上访问 */
+
+static struct cache_slot *slot_find(const char *key)
+{
+    struct cache_slot *free_slot = NULL;
+
+    for (size_t i = 0; i < ARRAY_SIZE(s_slots); i++) {
+        if (s_slots[i].key[0] == '\0') {
+            if (!free_slot) free_slot = &s_slots[i];
+        } else if (!strcmp(s_slots[i].key, key)) {
+            return &s_slots[i];
+        }
+    }
+    if (free_slot) {
+        strcpy(free_slot->key, key);
+    }
+    return free_slot;
+}
+
+int settings_cache_put(const char *key, const void *val, size_t len)
+{
+    if (!key || !val) return -EINVAL;
+
+    if (strlen(key) >= SETTINGS_CACHE_KEY_MAX || len > SETTINGS_CACHE_VAL_MAX) {
+        return settings_save_one(key, val, len);
+    }
+
+    k_mutex_lock(&s_lock, K_FOREVER);
+    struct cache_slot *s = slot_find(key);
+    if (s) {
+        memcpy(s->val, val, len);
+        s->len   = (uint8_t)len;
+        s->dirty = true;
+    }
+    k_mutex_unlock(&s_lock);
+
+    if (!s) {
+        LOG_WRN("cache full, write through: %s", key);
+        return settings_save_one(key, val, len);
+    }
+
+    /* 每次修改都把落盘往后推，拖动期间一次 flash 写都不发生 */
+    (void)k_work_reschedule(&s_flush_work, K_MSEC(SETTINGS_CACHE_QUIET_MS));
+    return 0;
+}
+
+void settings_cache_flush(void)
+{
+    (void)k_work_reschedule(&s_flush_work, K_NO_WAIT);
+}
+
+void settings_cache_seed(const char *key, const void *val, size_t len)
+{
+    if (!key || !val || strlen(key) >= SETTINGS_CACHE_KEY_MAX || len > SETTINGS_CACHE_VAL_MAX) {
+        return;
+    }
+
+    k_mutex_lock(&s_lock, K_FOREVER);
+    struct cache_slot *s = slot_find(key);
+    if (s && !s->dirty) {
+        memcpy(s->saved, val, len);
+        s->saved_len = (uint8_t)len;
+        memcpy(s->val, val, len);
+        s->len = (uint8_t)len;
+    }
+    k_mutex_unlock(&s_lock);
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    int written = 0, skipped = 0, failed = 0;
+
+    for (size_t i = 0; i < ARRAY_SIZE(s_slots); i++) {
+        char    key[SETTINGS_CACHE_KEY_MAX];
+        uint8_t val[SETTINGS_CACHE_VAL_MAX];
+        uint8_t len;
+
+        /* 只在拷贝时持锁，flash 写期间 UI 线程仍可继续 put */
+        k_mutex_lock(&s_lock, K_FOREVER);
+        struct cache_slot *s = &s_slots[i];
+        if (!s->dirty) {
+            k_mutex_unlock(&s_lock);
+            continue;
+        }
+        s->dirty = false;
+        if (s->len == s->saved_len && !memcmp(s->val, s->saved, s->len)) {
+            k_mutex_unlock(&s_lock);
+            skipped++;
+            continue;
+        }
+        strcpy(key, s->key);
+        memcpy(val, s->val, s->len);
+        len = s->len;
+        k_mutex_unlock(&s_lock);
+
+        int r = settings_save_one(key, val, len);
+        if (r) {
+            LOG_WRN("save %s failed: %d", key, r);
+            k_mutex_lock(&s_lock, K_FOREVER);
+            s->dirty = true;            /* 留着，退避后重试 */
+            k_mutex_unlock(&s_lock);
+            failed++;
+            continue;
+        }
+
+        k_mutex_lock(&s_lock, K_FOREVER);
+        memcpy(s->saved, val, len);
+        s->saved_len = len;
+        k_mutex_unlock(&s_lock);
+        written++;
+    }
+
+    if (written || skipped) {
+        LOG_INF("flushed %d key(s), %d unchanged", written, skipped);
+    }
+
+    /* 失败（如 NVS 正在回收扇区）不等下一次 put：按指数退避自己重排 */
+    if (failed) {
+        s_retry_ms = s_retry_ms ? MIN(s_retry_ms * 2U, SETTINGS_CACHE_RETRY_MAX_MS)
+                                : SETTINGS_CACHE_RETRY_MS;
+        LOG_WRN("%d key(s) failed, retry in %u ms", failed, s_retry_ms);
+        (void)k_work_reschedule(&s_flush_work, K_MSEC(s_retry_ms));
+    } else {
+        s_retry_ms = 0;
+    }
+}
+
+#else /* !CONFIG_SETTINGS */
+
+int settings_cache_put(const char *key, const void *val, size_t len)
+{
+    ARG_UNUSED(key); ARG_UNUSED(val); ARG_UNUSED(len);
+    return 0;
+}
+
+void settings_cache_flush(void) {}
+
+void settings_cache_seed(const char *key, const void *val, size_t len)
+{
+    ARG_UNUSED(key); ARG_UNUSED(val); ARG_UNUSED(len);
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SETTINGS_CACHE_H_
+#define SETTINGS_CACHE_H_
+
+/**
+ * @file settings_cache.h
+ * @brief settings 写回缓存：先改 RAM，静默一段时间后（或熄屏时）批量落 flash
+ *
+ * 滑块拖动这类高频修改只会覆盖缓存里同一条目，最后一次的值才写 flash；
+ * 与上次已写入的值相同的条目直接跳过。真正的 settings_save_one()
+ * 在系统工作队列里执行，不阻塞调用线程（UI）。
+ *
+ * 未启用 CONFIG_SETTINGS 时全部为空操作。
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SETTINGS_CACHE_QUIET_MS
+#define SETTINGS_CACHE_QUIET_MS   3000   /**< 最后一次修改后静默多久再落盘 */
+#endif
+#ifndef SETTINGS_CACHE_SLOTS
+#define SETTINGS_CACHE_SLOTS      8
+#endif
+#ifndef SETTINGS_CACHE_KEY_MAX
+#define SETTINGS_CACHE_KEY_MAX    24
+#endif
+#ifndef SETTINGS_CACHE_VAL_MAX
+#define SETTINGS_CACHE_VAL_MAX    32     /**< 需容纳 blsched/cfg（25B） */
+#endif
+#ifndef SETTINGS_CACHE_RETRY_MS
+#define SETTINGS_CACHE_RETRY_MS   1000   /**< 写 flash 失败后的首次重试间隔，之后每次翻倍 */
+#endif
+#ifndef SETTINGS_CACHE_RETRY_MAX_MS
+#define SETTINGS_CACHE_RETRY_MAX_MS 60000
+#endif
+
+/**
+ * 写入缓存并（重新）开始静默计时。
+ * key 过长、值过大或槽位用尽时退化为直接 settings_save_one()。
+ */
+int  settings_cache_put(const char *key, const void *val, size_t len);
+
+/** 立即把所有脏条目提交到工作队列落盘（熄屏、关机前调用） */
+void settings_cache_flush(void);
+
+/**
+ * 记下 flash 里已有的值（各模块的 settings set 处理函数在加载时调用）：
+ * 之后 put 回同样的值不会再写 flash。
+ */
+void settings_cache_seed(const char *key, const void *val, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SETTINGS_CACHE_H_ */
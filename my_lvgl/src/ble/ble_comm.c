@@ -8,10 +8,24 @@
 #include <zephyr/bluetooth/gap.h>
 #include <zephyr/bluetooth/uuid.h> 
 #include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
 
 LOG_MODULE_REGISTER(ble_comm, LOG_LEVEL_INF);
 #include "ble_defs.h"
 #include "ble_defs.h"
+#include "sensor/motion_state.h"
+#include "app/key_cmd.h"
+
+/* 广播间隔：佩戴中用快速间隔（100~150ms）便于手机发现；
+ * 静止（放在床头柜）时降到 1s 级，省射频功耗 */
+#define ADV_FAST_INT_MIN   BT_GAP_ADV_FAST_INT_MIN_2
+#define ADV_FAST_INT_MAX   BT_GAP_ADV_FAST_INT_MAX_2
+#define ADV_SLOW_INT_MIN   BT_GAP_ADV_SLOW_INT_MIN
+#define ADV_SLOW_INT_MAX   BT_GAP_ADV_SLOW_INT_MAX
+
+static bool s_adv_slow   = false;
+static bool s_connected  = false;
+static bool s_bt_ready   = false;
 
 static int advertise_start(void)
 {
@@ -23,15 +37,68 @@ static int advertise_start(void)
         BT_DATA(BT_DATA_UUID128_ALL, uuid_adv, sizeof(uuid_adv)),
     };
 
-    int err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+    const struct bt_le_adv_param *param = s_adv_slow ?
+        BT_LE_ADV_PARAM(BT_LE_ADV_OPT_CONNECTABLE | BT_LE_ADV_OPT_USE_NAME,
+                        ADV_SLOW_INT_MIN, ADV_SLOW_INT_MAX, NULL) :
+        BT_LE_ADV_PARAM(BT_LE_ADV_OPT_CONNECTABLE | BT_LE_ADV_OPT_USE_NAME,
+                        ADV_FAST_INT_MIN, ADV_FAST_INT_MAX, NULL);
+
+    int err = bt_le_adv_start(param, ad, ARRAY_SIZE(ad), NULL, 0);
     if (err) {
         LOG_ERR("bt_le_adv_start failed: %d", err);
         return err;
     }
-    LOG_INF("Advertising started");
+    LOG_INF("Advertising started (%s)", s_adv_slow ? "slow" : "fast");
     return 0;
 }
 
+/* 运动状态变化 → 切换广播间隔。bt_le_adv_* 不在 zbus 发布者上下文里调，挪到系统工作队列 */
+static void adv_rate_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+    if (!s_bt_ready || s_connected) return;   /* 已连接时不广播，断开后按新间隔重启 */
+    (void)ble_comm_advertise_restart();
+}
+static K_WORK_DEFINE(s_adv_rate_work, adv_rate_work_handler);
+
+static void ble_motion_cb(const struct zbus_channel *chan)
+{
+    const struct motion_msg *m = zbus_chan_const_msg(chan);
+    bool slow = (m->state == MOTION_STATIONARY);
+
+    if (slow != s_adv_slow) {
+        s_adv_slow = slow;
+        k_work_submit(&s_adv_rate_work);
+    }
+}
+ZBUS_LISTENER_DEFINE(ble_motion_listener, ble_motion_cb);
+ZBUS_CHAN_ADD_OBS(motion_chan, ble_motion_listener, 3);
+
+/* 按键长按：用户正拿着表找手机，强制切回快速广播并重启 */
+static void adv_key_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+    if (!s_bt_ready) return;
+    if (s_connected) {
+        LOG_INF("key adv restart ignored: connected");
+        return;
+    }
+    s_adv_slow = false;
+    (void)ble_comm_advertise_restart();
+}
+static K_WORK_DEFINE(s_adv_key_work, adv_key_work_handler);
+
+static void ble_key_cb(const struct zbus_channel *chan)
+{
+    const struct key_cmd_msg *m = zbus_chan_const_msg(chan);
+
+    if (m->cmd == KEY_CMD_BLE_ADV) {
+        k_work_submit(&s_adv_key_work);
+    }
+}
+ZBUS_LISTENER_DEFINE(ble_key_listener, ble_key_cb);
+ZBUS_CHAN_ADD_OBS(key_cmd_chan, ble_key_listener, 3);
+
 
 /* 连接回调：断开后自动重启广播 */
 static void on_connected(struct bt_conn *conn, uint8_t err)
@@ -41,12 +108,14 @@ static void on_connected(struct bt_conn *conn, uint8_t err)
         (void)advertise_start();
         return;
     }
+    s_connected = true;
     LOG_INF("Connected");
 }
 
 static void on_disconnected(struct bt_conn *conn, uint8_t reason)
 {
     LOG_INF("Disconnected (reason 0x%02X)", reason);
+    s_connected = false;
     (void)advertise_start();
 }
 
@@ -71,5 +140,6 @@ int ble_comm_init(void)
     LOG_INF("Bluetooth initialized");
 
     bt_conn_cb_register(&s_conn_cb);
+    s_bt_ready = true;
     return advertise_start();
 }
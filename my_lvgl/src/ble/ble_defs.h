@@ -12,6 +12,21 @@ enum {
     CMD_GET_TIME = 0x41, /* 获取时间（请求） */
     RSP_GET_TIME = 0x42, /* 获取时间（响应） */
 
+    CMD_SET_WWAKE = 0x02, /* 抬腕配置：[1]mode [2]arm [3..4]face_up_mg [5..6]max_dps，小端 */
+    CMD_GET_WWAKE = 0x43, /* 读抬腕配置 + 统计（请求） */
+    RSP_GET_WWAKE = 0x44, /* 读抬腕配置 + 统计（响应） */
+
+    CMD_SET_BL_SCHED = 0x03, /* 背光时段表：[1]first_hour [2]count(<=12) [3..]系数%；[1]=0xFF 时 [2]=开关 */
+    CMD_GET_BL_SCHED = 0x45, /* 读背光时段表（请求）：[1]first_hour */
+    RSP_GET_BL_SCHED = 0x46, /* 读背光时段表（响应） */
+
+    CMD_SET_PROFILE = 0x04, /* 用户资料：[1]身高cm [2]体重kg */
+    CMD_GET_METRICS = 0x47, /* 读运动指标（请求） */
+    RSP_GET_METRICS = 0x48, /* 读运动指标（响应） */
+
+    CMD_GET_IMU_DIAG = 0x49, /* 读 IMU 通信/恢复统计（请求） */
+    RSP_GET_IMU_DIAG = 0x4A, /* 读 IMU 通信/恢复统计（响应） */
+
     /* 预留：心率、六轴等
     CMD_HR_PUSH  = 0x10,
     CMD_IMU_PUSH = 0x20,
@@ -0,0 +1,65 @@
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ble_proto_blsched, LOG_LEVEL_INF);
+
+#include <zephyr/init.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+#include "ble_defs.h"
+#include "ble_proto.h"
+#include "ble_transport.h"
+#include "app/bl_schedule.h"
+
+/* 一帧最多带半天的系数：[3..14] */
+#define BLSCHED_PER_FRAME  12
+#define BLSCHED_CTRL_HOUR  0xFF
+
+/* 0x03: 写时段表 [1]first_hour [2]count [3..]系数%；
+ *       [1]=0xFF 时为开关：[2]=0 关 / 1 开 */
+static int handle_set_bl_sched(struct bt_conn *conn, const uint8_t *frame, uint16_t frame_len)
+{
+    ARG_UNUSED(conn);
+    if (frame_len != BLE_FRAME_LEN) return 0;
+
+    if (frame[1] == BLSCHED_CTRL_HOUR) {
+        (void)bl_schedule_set_enabled(frame[2] != 0);
+        return 0;
+    }
+
+    uint8_t first = frame[1], count = frame[2];
+    if (count > BLSCHED_PER_FRAME || bl_schedule_set(first, &frame[3], count) != 0) {
+        LOG_WRN("SET_BL_SCHED invalid: first=%u count=%u", first, count);
+        return 0;
+    }
+    LOG_INF("SET_BL_SCHED %02u..%02u", first, first + count - 1U);
+    return 0;
+}
+
+/* 0x45: 读时段表 [1]first_hour（0 或 12）→ 0x46:
+ * [1]first_hour [2]开关 [3..14]该小时起 12 个系数%
+ */
+static int handle_get_bl_sched(struct bt_conn *conn, const uint8_t *frame, uint16_t frame_len)
+{
+    if (frame_len != BLE_FRAME_LEN) return 0;
+
+    uint8_t tbl[BL_SCHED_HOURS];
+    bl_schedule_get(tbl);
+
+    uint8_t first = MIN(frame[1], BL_SCHED_HOURS - BLSCHED_PER_FRAME);
+
+    uint8_t rsp[BLE_FRAME_LEN] = {0};
+    rsp[0] = RSP_GET_BL_SCHED;
+    rsp[1] = first;
+    rsp[2] = bl_schedule_is_enabled() ? 1 : 0;
+    memcpy(&rsp[3], &tbl[first], BLSCHED_PER_FRAME);
+
+    ble_transport_send(conn, rsp, sizeof(rsp));
+    return 0;
+}
+
+static int blsched_proto_init(void)
+{
+    ble_proto_register(CMD_SET_BL_SCHED, handle_set_bl_sched);
+    ble_proto_register(CMD_GET_BL_SCHED, handle_get_bl_sched);
+    return 0;
+}
+SYS_INIT(blsched_proto_init, APPLICATION, 50);
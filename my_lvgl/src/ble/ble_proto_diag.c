@@ -0,0 +1,49 @@
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ble_proto_diag, LOG_LEVEL_INF);
+
+#include <zephyr/init.h>
+#include <zephyr/sys/byteorder.h>
+#include "ble_defs.h"
+#include "ble_proto.h"
+#include "ble_transport.h"
+#include "sensor/bmi270_hal.h"
+#include "sensor/steps_service.h"
+
+static inline uint16_t sat16(uint32_t v) { return (uint16_t)MIN(v, UINT16_MAX); }
+
+/* 0x49: IMU 诊断，小端、16bit 饱和：
+ * [1..2]comm_fail [3..4]retries [5..6]status_fail [7..8]bus_recover
+ * [9..10]recover_attempts [11..12]recover_ok [13]health_fail [14]state
+ */
+static int handle_get_imu_diag(struct bt_conn *conn, const uint8_t *frame, uint16_t frame_len)
+{
+    ARG_UNUSED(frame); ARG_UNUSED(frame_len);
+
+    struct bmi270_hal_stats hs;
+    struct steps_health     sh;
+    bmi270_hal_get_stats(&hs);
+    steps_service_get_health(&sh);
+
+    uint8_t rsp[BLE_FRAME_LEN] = {0};
+    rsp[0] = RSP_GET_IMU_DIAG;
+    sys_put_le16(sat16(hs.comm_fail),         &rsp[1]);
+    sys_put_le16(sat16(hs.retries),           &rsp[3]);
+    sys_put_le16(sat16(hs.status_fail),       &rsp[5]);
+    sys_put_le16(sat16(hs.bus_recover),       &rsp[7]);
+    sys_put_le16(sat16(sh.recover_attempts),  &rsp[9]);
+    sys_put_le16(sat16(sh.recover_ok),        &rsp[11]);
+    rsp[13] = (uint8_t)MIN(sh.health_fail, UINT8_MAX);
+    rsp[14] = sh.state;
+
+    ble_transport_send(conn, rsp, sizeof(rsp));
+    LOG_INF("GET_IMU_DIAG -> comm_fail=%u recover=%u/%u state=%u",
+            hs.comm_fail, sh.recover_ok, sh.recover_attempts, sh.state);
+    return 0;
+}
+
+static int diag_proto_init(void)
+{
+    ble_proto_register(CMD_GET_IMU_DIAG, handle_get_imu_diag);
+    return 0;
+}
+SYS_INIT(diag_proto_init, APPLICATION, 50);
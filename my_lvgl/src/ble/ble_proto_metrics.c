@@ -0,0 +1,57 @@
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ble_proto_metrics, LOG_LEVEL_INF);
+
+#include <zephyr/init.h>
+#include <zephyr/sys/byteorder.h>
+#include "ble_defs.h"
+#include "ble_proto.h"
+#include "ble_transport.h"
+#include "sensor/step_metrics.h"
+
+/* 0x04: 设置身高/体重（影响之后的步长与热量估算） */
+static int handle_set_profile(struct bt_conn *conn, const uint8_t *frame, uint16_t frame_len)
+{
+    ARG_UNUSED(conn);
+    if (frame_len != BLE_FRAME_LEN) return 0;
+
+    const struct step_metrics_profile p = {
+        .height_cm = frame[1],
+        .weight_kg = frame[2],
+    };
+    (void)step_metrics_set_profile(&p);
+    return 0;
+}
+
+/* 0x47: 直接取 metrics_chan 上最近一次发布的结果，小端：
+ * [1..4]steps [5..8]distance_m [9..12]kcal_x10 [13..14]cadence_spm
+ */
+static int handle_get_metrics(struct bt_conn *conn, const uint8_t *frame, uint16_t frame_len)
+{
+    ARG_UNUSED(frame); ARG_UNUSED(frame_len);
+
+    struct step_metrics_msg m;
+    if (zbus_chan_read(&metrics_chan, &m, K_MSEC(50)) != 0) {
+        LOG_WRN("metrics_chan read failed");
+        return 0;
+    }
+
+    uint8_t rsp[BLE_FRAME_LEN] = {0};
+    rsp[0] = RSP_GET_METRICS;
+    sys_put_le32(m.steps,       &rsp[1]);
+    sys_put_le32(m.distance_m,  &rsp[5]);
+    sys_put_le32(m.kcal_x10,    &rsp[9]);
+    sys_put_le16(m.cadence_spm, &rsp[13]);
+
+    ble_transport_send(conn, rsp, sizeof(rsp));
+    LOG_INF("GET_METRICS -> steps=%u dist=%um kcal=%u.%u cad=%u",
+            m.steps, m.distance_m, m.kcal_x10 / 10U, m.kcal_x10 % 10U, m.cadence_spm);
+    return 0;
+}
+
+static int metrics_proto_init(void)
+{
+    ble_proto_register(CMD_SET_PROFILE, handle_set_profile);
+    ble_proto_register(CMD_GET_METRICS, handle_get_metrics);
+    return 0;
+}
+SYS_INIT(metrics_proto_init, APPLICATION, 50);
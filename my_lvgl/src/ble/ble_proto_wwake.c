@@ -0,0 +1,59 @@
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ble_proto_wwake, LOG_LEVEL_INF);
+
+#include <zephyr/init.h>
+#include <zephyr/sys/byteorder.h>
+#include "ble_defs.h"
+#include "ble_proto.h"
+#include "ble_transport.h"
+#include "sensor/wrist_wake.h"
+
+/* 0x02: 设置抬腕参数，越界值由 wrist_wake 夹取 */
+static int handle_set_wwake(struct bt_conn *conn, const uint8_t *frame, uint16_t frame_len)
+{
+    ARG_UNUSED(conn);
+    if (frame_len != BLE_FRAME_LEN) return 0;
+
+    struct wrist_wake_cfg c = {
+        .mode           = frame[1],
+        .arm            = frame[2],
+        .min_face_up_mg = sys_get_le16(&frame[3]),
+        .max_rate_dps   = sys_get_le16(&frame[5]),
+    };
+    (void)wrist_wake_set_cfg(&c);
+    return 0;
+}
+
+/* 0x43: 回读配置，[7..12] 附带 gestures/wakes/rejects（各 16bit，饱和） */
+static int handle_get_wwake(struct bt_conn *conn, const uint8_t *frame, uint16_t frame_len)
+{
+    ARG_UNUSED(frame); ARG_UNUSED(frame_len);
+
+    struct wrist_wake_cfg c;
+    struct wrist_wake_stats st;
+    wrist_wake_get_cfg(&c);
+    wrist_wake_get_stats(&st);
+
+    uint8_t rsp[BLE_FRAME_LEN] = {0};
+    rsp[0] = RSP_GET_WWAKE;
+    rsp[1] = c.mode;
+    rsp[2] = c.arm;
+    sys_put_le16(c.min_face_up_mg, &rsp[3]);
+    sys_put_le16(c.max_rate_dps,   &rsp[5]);
+    sys_put_le16(MIN(st.gestures, UINT16_MAX), &rsp[7]);
+    sys_put_le16(MIN(st.wakes,    UINT16_MAX), &rsp[9]);
+    sys_put_le16(MIN(st.rejects,  UINT16_MAX), &rsp[11]);
+
+    ble_transport_send(conn, rsp, sizeof(rsp));
+    LOG_INF("GET_WWAKE -> mode=%u arm=%u wakes=%u rejects=%u",
+            c.mode, c.arm, st.wakes, st.rejects);
+    return 0;
+}
+
+static int wwake_proto_init(void)
+{
+    ble_proto_register(CMD_SET_WWAKE, handle_set_wwake);
+    ble_proto_register(CMD_GET_WWAKE, handle_get_wwake);
+    return 0;
+}
+SYS_INIT(wwake_proto_init, APPLICATION, 50);
@@ -38,7 +38,7 @@ static void time_update_cb(const struct zbus_channel *chan)
     } else {
         LOG_ERR("clock_settime failed, errno=%d", errno);
     }
-     /* 2) 让 UI 立刻刷新一次（内部用 lv_async_call 切回 LVGL 线程） */
+     /* 2) 让 UI 立刻刷新一次（内部经 ui_mailbox 切回 LVGL 线程） */
     ui_time_display_refresh();
 }
 
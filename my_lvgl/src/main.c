@@ -35,7 +35,7 @@ int main(void)
     ble_comm_init();         /* 开蓝牙 + 广播 + 连接回调 */
 	steps_service_start();
 	blctl_init();
-    key_ebtn_thread_init();   /* 线程版按键处理（无中断） */
+    key_ebtn_thread_init();   /* 按键：sw0 中断唤醒，活动期间轮询 */
 	ui_app_init();
 	    
 
@@ -12,10 +12,7 @@ LOG_MODULE_REGISTER(steps_hal, LOG_LEVEL_INF);
 #include "bmi270.h"
 #include "common.h"
 
-/* 覆盖/按需修改：左/右手；ACC 工作点 */
-#ifndef STEPS_WRIST_ARM
-#define STEPS_WRIST_ARM           BMI2_ARM_LEFT      /* 右手：BMI2_ARM_RIGHT */
-#endif
+/* 覆盖/按需修改：ACC 工作点（左/右手改由 wrist_wake 运行时配置） */
 #ifndef STEPS_ACC_ODR
 #define STEPS_ACC_ODR             BMI2_ACC_ODR_50HZ  /* 抬腕不够灵敏可改 BMI2_ACC_ODR_100HZ */
 #endif
@@ -25,10 +22,31 @@ LOG_MODULE_REGISTER(steps_hal, LOG_LEVEL_INF);
 #ifndef STEPS_ACC_RANGE
 #define STEPS_ACC_RANGE           BMI2_ACC_RANGE_4G
 #endif
+#ifndef STEPS_GYR_RANGE
+#define STEPS_GYR_RANGE           BMI2_GYR_RANGE_1000 /* 抬腕确认用，±1000dps 足够 */
+#endif
 #ifndef STEPS_ACC_FILTER_PERF
 #define STEPS_ACC_FILTER_PERF     BMI2_PERF_OPT_MODE
 #endif
 
+/* 运动状态：any/no-motion 参数（BMI270 单位：时长 1LSB=20ms，阈值 1LSB≈0.48mg） */
+#ifndef MOTION_ANY_DUR
+#define MOTION_ANY_DUR            4        /* 80ms 持续运动才算“动了” */
+#endif
+#ifndef MOTION_ANY_THRES
+#define MOTION_ANY_THRES          0xAA     /* ≈83mg，SDK 默认值 */
+#endif
+#ifndef MOTION_NO_MOT_DUR
+#define MOTION_NO_MOT_DUR         1500     /* 30s 无运动 → 静止 */
+#endif
+#ifndef MOTION_NO_MOT_THRES
+#define MOTION_NO_MOT_THRES       0x90     /* ≈70mg */
+#endif
+/* 静止时的 ACC 工作点：特性引擎需要 50Hz，不降 ODR，改为欠采样平均 + APS */
+#ifndef MOTION_LP_ACC_BWP
+#define MOTION_LP_ACC_BWP         BMI2_ACC_OSR2_AVG2
+#endif
+
 /* 从 DT 取 I2C 和 INT1 所在节点（bmi270@69） */
 #define BMI270_NODE DT_NODELABEL(bmi270)
 #if !DT_NODE_HAS_STATUS(BMI270_NODE, okay)
@@ -39,6 +57,13 @@ static const struct i2c_dt_spec s_i2c = I2C_DT_SPEC_GET(BMI270_NODE);
 /* 全局 BMI2 设备对象（本 HAL 内部使用） */
 static struct bmi2_dev s_bmi270_dev;
 
+/* 通信统计：只在 sensor_wq 上写，其它线程拷贝读取（32 位读写本身是原子的） */
+static struct bmi270_hal_stats s_stats;
+
+#ifndef BMI270_STATUS_RETRIES
+#define BMI270_STATUS_RETRIES     3
+#endif
+
 /* --- BMI2 适配：延时 + I2C 读写 --- */
 static void bmi2_delay_us(uint32_t period, void *intf_ptr)
 {
@@ -50,17 +75,30 @@ static int8_t bmi2_i2c_read(uint8_t reg_addr, uint8_t *reg_data, uint32_t length
 {
     const struct i2c_dt_spec *bus = (const struct i2c_dt_spec *)intf_ptr;
     int ret = i2c_burst_read_dt(bus, reg_addr, reg_data, length);
-    return (ret == 0) ? BMI2_OK : BMI2_E_COM_FAIL;
+    if (ret) {
+        s_stats.comm_fail++;
+        s_stats.last_err = ret;
+        return BMI2_E_COM_FAIL;
+    }
+    return BMI2_OK;
 }
 
 static int8_t bmi2_i2c_write(uint8_t reg_addr, const uint8_t *reg_data, uint32_t length, void *intf_ptr)
 {
     const struct i2c_dt_spec *bus = (const struct i2c_dt_spec *)intf_ptr;
     int ret = i2c_burst_write_dt(bus, reg_addr, reg_data, length);
-    return (ret == 0) ? BMI2_OK : BMI2_E_COM_FAIL;
+    if (ret) {
+        s_stats.comm_fail++;
+        s_stats.last_err = ret;
+        return BMI2_E_COM_FAIL;
+    }
+    return BMI2_OK;
 }
 
-/* 配置 INT1：高电平、推挽、输出使能、非锁存；并把给定特性映射到 INT1 */
+/* 配置 INT1：高电平、推挽、输出使能、锁存；并把给定特性映射到 INT1
+ * 锁存模式下 INT1 会一直保持有效电平，直到读 INT_STATUS（读即清），
+ * 同一波事件只产生一个上升沿，由上层一次读状态全部取走。
+ */
 static int map_feature_to_int1(uint8_t feature_type)
 {
     int8_t rslt;
@@ -75,7 +113,7 @@ static int map_feature_to_int1(uint8_t feature_type)
     pin.pin_cfg[0].od            = BMI2_INT_PUSH_PULL;
     pin.pin_cfg[0].output_en     = BMI2_INT_OUTPUT_ENABLE;
     pin.pin_cfg[0].input_en      = BMI2_INT_INPUT_DISABLE;
-    pin.int_latch                = BMI2_INT_NON_LATCH;
+    pin.int_latch                = BMI2_INT_LATCH;
 
     rslt = bmi2_set_int_pin_config(&pin, &s_bmi270_dev);
     if (rslt != BMI2_OK) return rslt;
@@ -90,6 +128,7 @@ int bmi270_steps_init(void)
         return -ENODEV;
     }
 
+    s_stats.inits++;
     memset(&s_bmi270_dev, 0, sizeof(s_bmi270_dev));
     s_bmi270_dev.intf      = BMI2_I2C_INTF;
     s_bmi270_dev.read      = bmi2_i2c_read;
@@ -121,17 +160,11 @@ int bmi270_steps_init(void)
         if (map_feature_to_int1(BMI2_STEP_DETECTOR) != BMI2_OK) return -EIO;
     }
 
-    /* 4) 使能 Wrist Gesture，并映射到 INT1；设置左/右手 */
+    /* 4) 使能 Wrist Gesture，并映射到 INT1（左/右手由 bmi270_set_wrist_arm 设置） */
     {
         uint8_t sens[] = { BMI2_ACCEL, BMI2_WRIST_GESTURE };
         (void)bmi270_sensor_enable(sens, 2, &s_bmi270_dev);
 
-        struct bmi2_sens_config cfg = { .type = BMI2_WRIST_GESTURE };
-        if (bmi270_get_sensor_config(&cfg, 1, &s_bmi270_dev) == BMI2_OK) {
-            cfg.cfg.wrist_gest.wearable_arm = STEPS_WRIST_ARM;
-            (void)bmi270_set_sensor_config(&cfg, 1, &s_bmi270_dev);
-        }
-
         if (map_feature_to_int1(BMI2_WRIST_GESTURE) != BMI2_OK) return -EIO;
     }
 
@@ -139,19 +172,58 @@ int bmi270_steps_init(void)
     return 0;
 }
 
-/* 轻重试 + 静音：避免偶发 E_COM_FAIL 刷屏 */
+/* 轻重试 + 静音：避免偶发 E_COM_FAIL 刷屏
+ * 锁存模式下这次读取同时会清除 INT1 的锁存电平。
+ */
 int bmi270_steps_get_int_status(uint16_t *int_status)
 {
     int8_t rslt;
-    for (int i = 0; i < 3; ++i) {
+    for (int i = 0; i < BMI270_STATUS_RETRIES; ++i) {
+        if (i > 0) s_stats.retries++;
         rslt = bmi2_get_int_status(int_status, &s_bmi270_dev);
         if (rslt == BMI2_OK) return 0;
         if (rslt == BMI2_E_COM_FAIL) { k_busy_wait(200); continue; }
         break;
     }
+    s_stats.status_fail++;
+    LOG_WRN("INT_STATUS read failed: rslt=%d i2c=%d (comm_fail=%u)",
+            rslt, s_stats.last_err, s_stats.comm_fail);
     return -EIO;
 }
 
+int bmi270_health_check(void)
+{
+    uint8_t id = 0, ist = 0;
+
+    if (bmi2_get_regs(BMI2_CHIP_ID_ADDR, &id, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+    if (id != BMI270_CHIP_ID) {
+        LOG_WRN("chip id 0x%02x != 0x%02x", id, BMI270_CHIP_ID);
+        return -ENODEV;
+    }
+    /* 掉电复位后 chip id 仍正常，但特性引擎配置已丢失：INTERNAL_STATUS 不再是 INIT_OK */
+    if (bmi2_get_regs(BMI2_INTERNAL_STATUS_ADDR, &ist, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+    if ((ist & BMI2_CONFIG_LOAD_STATUS_MASK) != BMI2_INIT_OK) {
+        LOG_WRN("internal status 0x%02x, feature engine lost", ist);
+        return -ENOEXEC;
+    }
+    return 0;
+}
+
+int bmi270_bus_recover(void)
+{
+    s_stats.bus_recover++;
+    int ret = i2c_recover_bus(s_i2c.bus);
+    if (ret) {
+        LOG_WRN("i2c_recover_bus: %d", ret);
+    }
+    return ret;
+}
+
+void bmi270_hal_get_stats(struct bmi270_hal_stats *out)
+{
+    if (out) *out = s_stats;
+}
+
 int bmi270_read_wrist_gesture(uint8_t *gesture)
 {
     struct bmi2_feat_sensor_data d = { .type = BMI2_WRIST_GESTURE };
@@ -159,3 +231,109 @@ int bmi270_read_wrist_gesture(uint8_t *gesture)
     *gesture = d.sens_data.wrist_gesture_output;
     return 0;
 }
+
+int bmi270_set_wrist_arm(uint8_t arm)
+{
+    struct bmi2_sens_config cfg = { .type = BMI2_WRIST_GESTURE };
+
+    if (bmi270_get_sensor_config(&cfg, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+    cfg.cfg.wrist_gest.wearable_arm = (arm == BMI2_ARM_RIGHT) ? BMI2_ARM_RIGHT : BMI2_ARM_LEFT;
+    if (bmi270_set_sensor_config(&cfg, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+    return 0;
+}
+
+int bmi270_set_gyro(bool on)
+{
+    uint8_t sens[] = { BMI2_GYRO };
+
+    if (!on) {
+        return (bmi270_sensor_disable(sens, 1, &s_bmi270_dev) == BMI2_OK) ? 0 : -EIO;
+    }
+
+    struct bmi2_sens_config gyr = { .type = BMI2_GYRO };
+    if (bmi2_get_sensor_config(&gyr, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+    gyr.cfg.gyr.odr         = BMI2_GYR_ODR_100HZ;
+    gyr.cfg.gyr.range       = STEPS_GYR_RANGE;
+    gyr.cfg.gyr.bwp         = BMI2_GYR_NORMAL_MODE;
+    gyr.cfg.gyr.filter_perf = BMI2_POWER_OPT_MODE;
+    gyr.cfg.gyr.noise_perf  = BMI2_POWER_OPT_MODE;
+    if (bmi2_set_sensor_config(&gyr, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+
+    return (bmi270_sensor_enable(sens, 1, &s_bmi270_dev) == BMI2_OK) ? 0 : -EIO;
+}
+
+int bmi270_read_motion_sample(struct bmi270_motion_sample *out)
+{
+    struct bmi2_sens_data d = { 0 };
+
+    if (bmi2_get_sensor_data(&d, &s_bmi270_dev) != BMI2_OK) return -EIO;
+
+    out->acc[0] = d.acc.x; out->acc[1] = d.acc.y; out->acc[2] = d.acc.z;
+    out->gyr[0] = d.gyr.x; out->gyr[1] = d.gyr.y; out->gyr[2] = d.gyr.z;
+    return 0;
+}
+
+int bmi270_motion_init(void)
+{
+    struct bmi2_sens_config cfg[2] = {
+        { .type = BMI2_ANY_MOTION },
+        { .type = BMI2_NO_MOTION },
+    };
+
+    if (bmi270_get_sensor_config(cfg, 2, &s_bmi270_dev) != BMI2_OK) return -EIO;
+
+    cfg[0].cfg.any_motion.duration  = MOTION_ANY_DUR;
+    cfg[0].cfg.any_motion.threshold = MOTION_ANY_THRES;
+    cfg[0].cfg.any_motion.select_x  = BMI2_ENABLE;
+    cfg[0].cfg.any_motion.select_y  = BMI2_ENABLE;
+    cfg[0].cfg.any_motion.select_z  = BMI2_ENABLE;
+
+    cfg[1].cfg.no_motion.duration   = MOTION_NO_MOT_DUR;
+    cfg[1].cfg.no_motion.threshold  = MOTION_NO_MOT_THRES;
+    cfg[1].cfg.no_motion.select_x   = BMI2_ENABLE;
+    cfg[1].cfg.no_motion.select_y   = BMI2_ENABLE;
+    cfg[1].cfg.no_motion.select_z   = BMI2_ENABLE;
+
+    if (bmi270_set_sensor_config(cfg, 2, &s_bmi270_dev) != BMI2_OK) return -EIO;
+
+    uint8_t sens[] = { BMI2_ANY_MOTION, BMI2_NO_MOTION, BMI2_STEP_ACTIVITY };
+    if (bmi270_sensor_enable(sens, ARRAY_SIZE(sens), &s_bmi270_dev) != BMI2_OK) return -EIO;
+
+    for (size_t i = 0; i < ARRAY_SIZE(sens); i++) {
+        if (map_feature_to_int1(sens[i]) != BMI2_OK) return -EIO;
+    }
+
+    LOG_INF("BMI270 motion features ready: any/no-motion + step activity on INT1");
+    return 0;
+}
+
+int bmi270_read_step_activity(uint8_t *activity)
+{
+    struct bmi2_feat_sensor_data d = { .type = BMI2_STEP_ACTIVITY };
+    if (bmi270_get_feature_data(&d, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+    *activity = d.sens_data.activity_output;
+    return 0;
+}
+
+int bmi270_set_low_power(bool low_power)
+{
+    struct bmi2_sens_config acc = { .type = BMI2_ACCEL };
+
+    /* 进入性能模式：先关 APS，后续寄存器写入不必再等 APS 唤醒时间 */
+    if (!low_power && bmi2_set_adv_power_save(BMI2_DISABLE, &s_bmi270_dev) != BMI2_OK) {
+        return -EIO;
+    }
+
+    if (bmi2_get_sensor_config(&acc, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+    acc.cfg.acc.odr         = STEPS_ACC_ODR;
+    acc.cfg.acc.range       = STEPS_ACC_RANGE;
+    acc.cfg.acc.filter_perf = low_power ? BMI2_POWER_OPT_MODE : STEPS_ACC_FILTER_PERF;
+    acc.cfg.acc.bwp         = low_power ? MOTION_LP_ACC_BWP   : STEPS_ACC_BWP;
+    if (bmi2_set_sensor_config(&acc, 1, &s_bmi270_dev) != BMI2_OK) return -EIO;
+
+    /* 进入低功耗：配置写完再开 APS */
+    if (low_power && bmi2_set_adv_power_save(BMI2_ENABLE, &s_bmi270_dev) != BMI2_OK) {
+        return -EIO;
+    }
+    return 0;
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <stdint.h>
+#include <stdbool.h>
 
 
 
@@ -7,16 +8,74 @@
  * - 绑定 I2C（来自 DT 的 node-label: bmi270）
  * - bmi270_init()
  * - 调整 ACC 工作点（更稳：ODR 50Hz/100Hz、窄带宽、±4g）
- * - 启用 Step Detector + Wrist Gesture 并映射到 INT1（高电平有效）
+ * - 启用 Step Detector + Wrist Gesture 并映射到 INT1（高电平有效、锁存）
+ * 左/右手不在这里设置，见 bmi270_set_wrist_arm()。
  */
 int bmi270_steps_init(void);
 
-/* 读取 BMI270 的“特性中断状态位” */
+/* 读取 BMI270 的“特性中断状态位”
+ * INT1 工作在锁存模式：读 INT_STATUS 即清中断，一次 I2C 事务取走一整波事件。
+ */
 int bmi270_steps_get_int_status(uint16_t *int_status);
 
+/* 健康检查：chip id 对得上、特性引擎仍处于 INIT_OK（没被掉电复位） */
+int bmi270_health_check(void);
+
+/* 总线卡死（SDA 被从机拉低）时打 9 个 SCL 脉冲释放总线 */
+int bmi270_bus_recover(void);
+
+/* 通信统计，用于定位“为什么不计步了” */
+struct bmi270_hal_stats {
+    uint32_t comm_fail;     /* I2C 事务失败（读 + 写） */
+    uint32_t retries;       /* INT_STATUS 重试次数 */
+    uint32_t status_fail;   /* 重试用尽仍失败 */
+    uint32_t bus_recover;   /* 总线恢复次数 */
+    uint32_t inits;         /* bmi270_steps_init 调用次数（含上电那次） */
+    int32_t  last_err;      /* 最近一次 I2C 错误码 */
+};
+void bmi270_hal_get_stats(struct bmi270_hal_stats *out);
+
 /* 读取 Wrist Gesture 的手势输出（如 pivot_up=2）。
  * 返回 0 表示成功，*gesture 为手势编码。
  */
 int bmi270_read_wrist_gesture(uint8_t *gesture);
 
+/* 设置 Wrist Gesture 的佩戴手：BMI2_ARM_LEFT(0) / BMI2_ARM_RIGHT(1) */
+int bmi270_set_wrist_arm(uint8_t arm);
+
+/* 开/关陀螺仪（100Hz，±1000dps，省电滤波），用于抬腕后的短时确认 */
+int bmi270_set_gyro(bool on);
+
+/* 一帧原始 ACC + GYR 数据（LSB）
+ * ACC ±4g：8192 LSB/g；GYR ±1000dps：32.768 LSB/(°/s)
+ */
+struct bmi270_motion_sample {
+    int16_t acc[3];
+    int16_t gyr[3];
+};
+#define BMI270_ACC_LSB_PER_G      8192
+#define BMI270_GYR_LSB_PER_KDPS   32768   /* 每 1000°/s */
+
+int bmi270_read_motion_sample(struct bmi270_motion_sample *out);
+
+/* Step Activity 输出编码（bmi270_read_step_activity） */
+#define BMI270_STEP_ACT_STILL     0
+#define BMI270_STEP_ACT_WALKING   1
+#define BMI270_STEP_ACT_RUNNING   2
+#define BMI270_STEP_ACT_UNKNOWN   3
+
+/* 启用 any-motion / no-motion / step-activity 并映射到 INT1（锁存）
+ * 需在 bmi270_steps_init() 成功之后调用。
+ */
+int bmi270_motion_init(void);
+
+/* 读取 Step Activity 输出（BMI270_STEP_ACT_*） */
+int bmi270_read_step_activity(uint8_t *activity);
+
+/* 切换 ACC 工作点：
+ *  low_power=true ：欠采样平均（power-opt）+ 高级省电（APS），静止时使用
+ *  low_power=false：性能滤波模式，关闭 APS，佩戴活动时使用
+ */
+int bmi270_set_low_power(bool low_power);
+
 
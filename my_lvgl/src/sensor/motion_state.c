@@ -0,0 +1,80 @@
+#include "motion_state.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(motion_state, LOG_LEVEL_INF);
+
+#include "bmi270_hal.h"
+#include "../third_party/bosch_bmi270/bmi270.h"
+
+ZBUS_CHAN_DEFINE(motion_chan, struct motion_msg, NULL, NULL,
+                 ZBUS_OBSERVERS_EMPTY,
+                 ZBUS_MSG_INIT(.state = MOTION_ACTIVE, .activity = BMI270_STEP_ACT_UNKNOWN));
+
+/* 只在 sensor_wq 上写；其它线程只读 */
+static atomic_t s_state = ATOMIC_INIT(MOTION_ACTIVE);
+static uint8_t  s_activity = BMI270_STEP_ACT_UNKNOWN;
+
+static void publish_state(enum motion_state st)
+{
+    atomic_set(&s_state, st);
+
+    const struct motion_msg m = { .state = st, .activity = s_activity };
+    (void)zbus_chan_pub(&motion_chan, &m, K_NO_WAIT);
+    LOG_INF("motion -> %s", (st == MOTION_STATIONARY) ? "STATIONARY" : "ACTIVE");
+}
+
+static void set_state(enum motion_state st)
+{
+    if ((enum motion_state)atomic_get(&s_state) == st) return;
+
+    bool low_power = (st == MOTION_STATIONARY);
+    if (bmi270_set_low_power(low_power) != 0) {
+        LOG_WRN("switch BMI270 %s mode failed", low_power ? "low-power" : "performance");
+    }
+    publish_state(st);
+}
+
+int motion_state_init(void)
+{
+    int ret = bmi270_motion_init();
+    if (ret) {
+        LOG_ERR("bmi270_motion_init failed: %d", ret);
+        return ret;
+    }
+    /* 上电默认按“佩戴中”处理，等 no-motion 超时再降。
+     * steps_service 恢复时也会重跑这里：之前若已是 STATIONARY，
+     * 要把 ACTIVE 发布出去，否则订阅者停在旧状态 */
+    ret = bmi270_set_low_power(false);
+    if ((enum motion_state)atomic_get(&s_state) != MOTION_ACTIVE) {
+        publish_state(MOTION_ACTIVE);
+    }
+    return ret;
+}
+
+void motion_state_on_int(uint16_t st)
+{
+    if (st & BMI270_STEP_ACT_STATUS_MASK) {
+        uint8_t act;
+        if (bmi270_read_step_activity(&act) == 0) {
+            s_activity = act;
+        }
+    }
+
+    /* 同一波里既有 no-motion 又有运动类事件时，以运动为准 */
+    bool moving = (st & (BMI270_ANY_MOT_STATUS_MASK | BMI270_STEP_CNT_STATUS_MASK)) ||
+                  ((st & BMI270_STEP_ACT_STATUS_MASK) &&
+                   (s_activity == BMI270_STEP_ACT_WALKING || s_activity == BMI270_STEP_ACT_RUNNING));
+
+    if (moving) {
+        set_state(MOTION_ACTIVE);
+    } else if (st & BMI270_NO_MOT_STATUS_MASK) {
+        set_state(MOTION_STATIONARY);
+    }
+}
+
+bool motion_state_is_stationary(void)
+{
+    return atomic_get(&s_state) == MOTION_STATIONARY;
+}
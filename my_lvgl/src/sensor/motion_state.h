@@ -0,0 +1,30 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr/zbus/zbus.h>
+
+/* 佩戴者运动状态：
+ *  - ACTIVE    ：有运动/在走路，BMI270 用性能模式
+ *  - STATIONARY：no-motion 持续超时（比如放在床头柜），BMI270 切低功耗，
+ *                背光/广播等模块收到通知后自行降耗
+ */
+enum motion_state {
+    MOTION_ACTIVE = 0,
+    MOTION_STATIONARY,
+};
+
+struct motion_msg {
+    uint8_t state;      /* enum motion_state */
+    uint8_t activity;   /* BMI270_STEP_ACT_*（最近一次 step-activity 输出） */
+};
+
+/* 状态变化时发布；订阅者用 ZBUS_CHAN_ADD_OBS 挂到本信道 */
+ZBUS_CHAN_DECLARE(motion_chan);
+
+/* 在 BMI270 初始化成功后调用（运行在 sensor_wq 上） */
+int  motion_state_init(void);
+
+/* 由步数服务在 sensor_wq 上把每次读到的 INT_STATUS 转交过来 */
+void motion_state_on_int(uint16_t int_status);
+
+bool motion_state_is_stationary(void);
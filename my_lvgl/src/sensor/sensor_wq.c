@@ -0,0 +1,24 @@
+#include "sensor_wq.h"
+
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(sensor_wq, LOG_LEVEL_INF);
+
+K_THREAD_STACK_DEFINE(sensor_wq_stack, SENSOR_WQ_STACK);
+static struct k_work_q s_sensor_wq;
+
+struct k_work_q *sensor_wq(void)
+{
+    return &s_sensor_wq;
+}
+
+static int sensor_wq_init(void)
+{
+    const struct k_work_queue_config cfg = { .name = "sensor_wq" };
+
+    k_work_queue_start(&s_sensor_wq, sensor_wq_stack,
+                       K_THREAD_STACK_SIZEOF(sensor_wq_stack),
+                       SENSOR_WQ_PRIO, &cfg);
+    return 0;
+}
+SYS_INIT(sensor_wq_init, APPLICATION, 40);
@@ -0,0 +1,17 @@
+#pragma once
+#include <zephyr/kernel.h>
+
+/* 传感器共享工作队列：
+ * - 步数、抬腕等传感器服务都以 work item 形式在这里串行执行
+ * - 所有 BMI270 的 I2C 访问都发生在该队列上下文，天然互斥，无需额外加锁
+ * - 多个服务共用一份栈，不再各自占一个常驻线程
+ */
+#ifndef SENSOR_WQ_STACK
+#define SENSOR_WQ_STACK   2048
+#endif
+#ifndef SENSOR_WQ_PRIO
+#define SENSOR_WQ_PRIO    7
+#endif
+
+/* 取得共享队列（SYS_INIT 阶段已启动） */
+struct k_work_q *sensor_wq(void);
@@ -0,0 +1,221 @@
+#include "step_metrics.h"
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(step_metrics, LOG_LEVEL_INF);
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+#include <zephyr/settings/settings.h>
+#endif
+
+#include "sensor_wq.h"
+#include "app/settings_cache.h"
+
+/* ========== 参数（可 -D 覆盖） ========== */
+#ifndef STEP_METRICS_WIN
+#define STEP_METRICS_WIN      16      /* 步频滑动窗口：最近 N 步 */
+#endif
+#ifndef STEP_METRICS_IDLE_MS
+#define STEP_METRICS_IDLE_MS  2500    /* 超过该间隔视为停走：窗口清空、步频归零 */
+#endif
+#ifndef STEP_METRICS_PUB_MS
+#define STEP_METRICS_PUB_MS   1000    /* 发布节流：每秒最多一次 */
+#endif
+
+/* 步频 → 步长/身高系数（Q10），慢走 0.37，跑步 0.60，中间线性插值 */
+#define CAD_WALK_SPM          80
+#define CAD_RUN_SPM           160
+#define STRIDE_WALK_Q10       379
+#define STRIDE_RUN_Q10        614
+/* 能耗系数 kcal/(kg·km)（Q8），走 0.5，跑 1.0 */
+#define KCAL_WALK_Q8          128
+#define KCAL_RUN_Q8           256
+/* weight_kg * stride_mm * k_q8 → 0.1kcal 的除数：1e6(mm→km) * 256(Q8) / 10 */
+#define KCAL_X10_DIV          25600000U
+
+/* ========== zbus：派生指标 ========== */
+static void metrics_ui_listener_cb(const struct zbus_channel *chan);
+ZBUS_LISTENER_DEFINE(metrics_ui_listener, metrics_ui_listener_cb);
+
+ZBUS_CHAN_DEFINE(metrics_chan, struct step_metrics_msg, NULL, NULL,
+                 ZBUS_OBSERVERS(metrics_ui_listener),
+                 ZBUS_MSG_INIT(0));
+
+extern void ui_steps_display_set_metrics(uint32_t distance_m, uint32_t kcal_x10);
+static void metrics_ui_listener_cb(const struct zbus_channel *chan)
+{
+    if (chan != &metrics_chan) return;
+    const struct step_metrics_msg *m = zbus_chan_const_msg(chan);
+    ui_steps_display_set_metrics(m->distance_m, m->kcal_x10);
+}
+
+/* ========== 用户资料 ========== */
+static struct k_spinlock s_lock;
+static struct step_metrics_profile s_profile = {
+    .height_cm = STEP_METRICS_HEIGHT_DEFAULT,
+    .weight_kg = STEP_METRICS_WEIGHT_DEFAULT,
+};
+
+static void profile_sanitize(struct step_metrics_profile *p)
+{
+    p->height_cm = CLAMP(p->height_cm, 100, 230);
+    p->weight_kg = CLAMP(p->weight_kg, 20, 250);
+}
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+/* settings: /metrics/profile */
+static int metrics_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+                                void *cb_arg)
+{
+    if (!strcmp(name, "profile") && len == sizeof(struct step_metrics_profile)) {
+        struct step_metrics_profile p;
+        if (read_cb(cb_arg, &p, sizeof(p)) != sizeof(p)) return -EIO;
+        settings_cache_seed("metrics/profile", &p, sizeof(p));
+        profile_sanitize(&p);
+
+        k_spinlock_key_t key = k_spin_lock(&s_lock);
+        s_profile = p;
+        k_spin_unlock(&s_lock, key);
+        return 0;
+    }
+    return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(metrics, "metrics", NULL, metrics_settings_set, NULL, NULL);
+
+static inline void metrics_save_profile(const struct step_metrics_profile *p)
+{
+    (void)settings_cache_put("metrics/profile", p, sizeof(*p));
+}
+#else
+static inline void metrics_save_profile(const struct step_metrics_profile *p) { ARG_UNUSED(p); }
+#endif
+
+/* ========== 累计状态：只在 sensor_wq 上访问 ========== */
+static int64_t  s_ts[STEP_METRICS_WIN];   /* 步时间戳环 */
+static uint8_t  s_ts_head;                /* 下一个写入位置 */
+static uint8_t  s_ts_cnt;
+static int64_t  s_last_ms = INT64_MIN;
+
+static uint32_t s_steps;
+static uint16_t s_cadence;
+static uint16_t s_stride_mm;
+static uint64_t s_dist_mm;
+static uint32_t s_kcal_x10;
+static uint32_t s_kcal_rem;               /* 不足 0.1kcal 的余数，避免逐步截断累积误差 */
+
+static void pub_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(s_pub_work, pub_work_handler);
+
+/* 在 [CAD_WALK, CAD_RUN] 之间对 lo..hi 线性插值 */
+static uint32_t lerp_by_cadence(uint32_t cad, uint32_t lo, uint32_t hi)
+{
+    if (cad <= CAD_WALK_SPM) return lo;
+    if (cad >= CAD_RUN_SPM)  return hi;
+    return lo + (hi - lo) * (cad - CAD_WALK_SPM) / (CAD_RUN_SPM - CAD_WALK_SPM);
+}
+
+/* 窗口内 (n-1) 个间隔的平均步频，四舍五入 */
+static uint16_t window_cadence(void)
+{
+    if (s_ts_cnt < 2) return 0;
+
+    uint8_t newest = (s_ts_head + STEP_METRICS_WIN - 1) % STEP_METRICS_WIN;
+    uint8_t oldest = (s_ts_head + STEP_METRICS_WIN - s_ts_cnt) % STEP_METRICS_WIN;
+    uint32_t span  = (uint32_t)(s_ts[newest] - s_ts[oldest]);
+    if (span == 0) return 0;
+
+    uint32_t n = s_ts_cnt - 1U;
+    return (uint16_t)MIN((n * 60000U + span / 2U) / span, UINT16_MAX);
+}
+
+void step_metrics_on_step(int64_t now_ms, uint32_t total_steps)
+{
+    /* 停顿过久：新的一段行走，旧窗口不参与步频 */
+    if (s_last_ms == INT64_MIN || (now_ms - s_last_ms) > STEP_METRICS_IDLE_MS) {
+        s_ts_cnt = 0;
+    }
+    s_last_ms = now_ms;
+
+    s_ts[s_ts_head] = now_ms;
+    s_ts_head = (s_ts_head + 1U) % STEP_METRICS_WIN;
+    if (s_ts_cnt < STEP_METRICS_WIN) s_ts_cnt++;
+
+    uint32_t added = (total_steps > s_steps) ? (total_steps - s_steps) : 1U;
+    s_steps   = total_steps;
+    s_cadence = window_cadence();
+
+    struct step_metrics_profile p;
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    p = s_profile;
+    k_spin_unlock(&s_lock, key);
+
+    /* 窗口还没攒够两步时按慢走估算 */
+    uint32_t f_q10  = lerp_by_cadence(s_cadence, STRIDE_WALK_Q10, STRIDE_RUN_Q10);
+    uint32_t k_q8   = lerp_by_cadence(s_cadence, KCAL_WALK_Q8, KCAL_RUN_Q8);
+    s_stride_mm     = (uint16_t)(((uint32_t)p.height_cm * 10U * f_q10) >> 10);
+
+    s_dist_mm  += (uint64_t)s_stride_mm * added;
+
+    uint64_t e = (uint64_t)p.weight_kg * s_stride_mm * k_q8 * added + s_kcal_rem;
+    s_kcal_x10 += (uint32_t)(e / KCAL_X10_DIV);
+    s_kcal_rem  = (uint32_t)(e % KCAL_X10_DIV);
+
+    /* 节流：已排在 PUB_MS 内的发布不动；只有空闲或挂着“归零”那一次长延时才提前 */
+    if (!k_work_delayable_is_pending(&s_pub_work) ||
+        k_work_delayable_remaining_get(&s_pub_work) > k_ms_to_ticks_ceil64(STEP_METRICS_PUB_MS)) {
+        (void)k_work_reschedule_for_queue(sensor_wq(), &s_pub_work,
+                                          K_MSEC(STEP_METRICS_PUB_MS));
+    }
+}
+
+static void pub_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    bool idle = (k_uptime_get() - s_last_ms) > STEP_METRICS_IDLE_MS;
+
+    const struct step_metrics_msg m = {
+        .steps       = s_steps,
+        .distance_m  = (uint32_t)(s_dist_mm / 1000U),
+        .kcal_x10    = s_kcal_x10,
+        .cadence_spm = idle ? 0 : s_cadence,
+        .stride_mm   = s_stride_mm,
+    };
+    (void)zbus_chan_pub(&metrics_chan, &m, K_NO_WAIT);
+    LOG_DBG("metrics: steps=%u cad=%u stride=%umm dist=%um kcal=%u.%u",
+            m.steps, m.cadence_spm, m.stride_mm, m.distance_m,
+            m.kcal_x10 / 10U, m.kcal_x10 % 10U);
+
+    /* 还在走：停走超时后再发一次，让订阅者看到步频归零 */
+    if (!idle) {
+        (void)k_work_schedule_for_queue(sensor_wq(), &s_pub_work,
+                                        K_MSEC(STEP_METRICS_IDLE_MS));
+    }
+}
+
+int step_metrics_set_profile(const struct step_metrics_profile *p)
+{
+    if (!p) return -EINVAL;
+
+    struct step_metrics_profile c = *p;
+    profile_sanitize(&c);
+
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    s_profile = c;
+    k_spin_unlock(&s_lock, key);
+
+    metrics_save_profile(&c);
+    LOG_INF("profile: %ucm %ukg", c.height_cm, c.weight_kg);
+    return 0;
+}
+
+void step_metrics_get_profile(struct step_metrics_profile *out)
+{
+    if (!out) return;
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    *out = s_profile;
+    k_spin_unlock(&s_lock, key);
+}
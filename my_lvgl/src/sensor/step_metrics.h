@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include <zephyr/zbus/zbus.h>
+
+/* 步数派生指标：由每一步的时间戳增量更新，全部定点运算
+ *  - cadence ：最近 STEP_METRICS_WIN 步的滑动步频（步/分）
+ *  - stride  ：按身高 × 步频相关系数估算的步长
+ *  - distance：逐步累加步长
+ *  - kcal    ：体重 × 距离 × 能耗系数（走/跑插值）
+ * 节流后发布到 metrics_chan，UI / BLE 直接取现成结果
+ */
+struct step_metrics_msg {
+    uint32_t steps;
+    uint32_t distance_m;
+    uint32_t kcal_x10;      /* 0.1 kcal */
+    uint16_t cadence_spm;   /* 步/分，停走 STEP_METRICS_IDLE_MS 后归零 */
+    uint16_t stride_mm;     /* 最近一步的估算步长 */
+};
+
+/* 用户资料：用于步长与热量估算，持久化到 settings "metrics/profile" */
+struct step_metrics_profile {
+    uint8_t height_cm;
+    uint8_t weight_kg;
+};
+
+#ifndef STEP_METRICS_HEIGHT_DEFAULT
+#define STEP_METRICS_HEIGHT_DEFAULT   170
+#endif
+#ifndef STEP_METRICS_WEIGHT_DEFAULT
+#define STEP_METRICS_WEIGHT_DEFAULT   65
+#endif
+
+ZBUS_CHAN_DECLARE(metrics_chan);
+
+/* 步数服务每确认一步调用一次（sensor_wq 上下文） */
+void step_metrics_on_step(int64_t now_ms, uint32_t total_steps);
+
+int  step_metrics_set_profile(const struct step_metrics_profile *p);
+void step_metrics_get_profile(struct step_metrics_profile *out);
@@ -7,8 +7,12 @@
 LOG_MODULE_REGISTER(steps_app, LOG_LEVEL_INF);
 
 #include "bmi270_hal.h"
-#include "../third_party/bosch_bmi270/bmi270.h"  
-#include "app/backlight_ctrl.h"
+#include "sensor_wq.h"
+#include "motion_state.h"
+#include "wrist_wake.h"
+#include "step_metrics.h"
+#include "steps_service.h"
+#include "../third_party/bosch_bmi270/bmi270.h"
 /* ========== zbus：步数消息（UI订阅者已在别处实现） ========== */
 struct steps_msg { uint32_t steps; };
 
@@ -37,35 +41,243 @@ static inline void publish_steps(uint32_t steps)
 #define BMI270_NODE DT_NODELABEL(bmi270)
 static const struct gpio_dt_spec s_int1 = GPIO_DT_SPEC_GET(BMI270_NODE, irq_gpios);
 
-/* ========== 线程 & 去抖参数 ========== */
-#define STEP_STACK      2048
-#define STEP_PRIO       7
+/* ========== 去抖参数 ========== */
 #define MIN_STEP_MS     300   /* 两步最小间隔：调 250~400ms 过滤轻微晃动 */
 
-K_THREAD_STACK_DEFINE(step_stack, STEP_STACK);
-static struct k_thread step_thread;
-static K_SEM_DEFINE(s_irq_sem, 0, 64);
+/* ========== 恢复参数（可 -D 覆盖） ========== */
+#ifndef STEPS_FAIL_LIMIT
+#define STEPS_FAIL_LIMIT        3       /* 连续 N 次读状态失败 → 进入恢复 */
+#endif
+#ifndef STEPS_RETRY_MS
+#define STEPS_RETRY_MS          10      /* 读状态失败后隔这么久再读，给瞬时干扰留出恢复时间 */
+#endif
+#ifndef STEPS_BACKOFF_MIN_MS
+#define STEPS_BACKOFF_MIN_MS    200
+#endif
+#ifndef STEPS_BACKOFF_MAX_MS
+#define STEPS_BACKOFF_MAX_MS    60000   /* 退避上限：传感器真坏了也只是每分钟试一次 */
+#endif
+#ifndef STEPS_HEALTH_MS
+#define STEPS_HEALTH_MS         60000   /* 周期健康检查 + 统计日志 */
+#endif
+
+/* ========== 状态机：全部在 sensor_wq 上以 work item 推进 ==========
+ * IDLE  --start-->  INIT  --init ok-->  READY
+ *                    |                  |  连续 STEPS_FAIL_LIMIT 次读失败
+ *                    |                  |  或健康检查发现芯片复位
+ *                    |                  v
+ *                    +--init fail--> RECOVER --总线恢复 + 重新初始化 ok--> READY
+ *                                       ^  |
+ *                                       +--+ 失败：指数退避后再试
+ *
+ * READY 状态下：INT1 上升沿 → ISR 只提交 s_irq_work；
+ * work 里读一次 INT_STATUS（锁存模式下读即清），一次 I2C 事务取走整波事件。
+ * 若 work 尚在队列中，再次提交会被 k_work 自动合并，不会产生多余的状态读取。
+ * RECOVER 期间关闭 INT1 中断，避免卡死的电平反复触发。
+ */
+enum steps_state {
+    STEPS_ST_IDLE = 0,
+    STEPS_ST_INIT,
+    STEPS_ST_READY,
+    STEPS_ST_RECOVER,
+};
+
+static enum steps_state s_state = STEPS_ST_IDLE;
+static struct k_work    s_init_work;
+static struct k_work_delayable s_irq_work;   /* 平时立即执行；读失败时延后 STEPS_RETRY_MS 重试 */
+static struct k_work_delayable s_recover_work;
+static struct k_work_delayable s_health_work;
+static struct gpio_callback s_cb;
+
+static uint32_t s_total;
+static int64_t  s_last_step_ms = -100000;
+
+static uint8_t  s_fail_streak;
+static uint32_t s_backoff_ms = STEPS_BACKOFF_MIN_MS;
+static struct steps_health s_health;
 
 static void int1_isr(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
 {
     ARG_UNUSED(dev); ARG_UNUSED(cb); ARG_UNUSED(pins);
-    k_sem_give(&s_irq_sem);
+    (void)k_work_reschedule_for_queue(sensor_wq(), &s_irq_work, K_NO_WAIT);
+}
+
+/* 1) 单步事件（这版 SDK 中 Detector/Counter 共用 0x02 状态位） */
+static void handle_step(uint16_t st)
+{
+    if (!(st & BMI270_STEP_CNT_STATUS_MASK)) return;
+
+    int64_t now = k_uptime_get();
+    if ((now - s_last_step_ms) >= MIN_STEP_MS) {
+        s_last_step_ms = now;
+        s_total++;
+        publish_steps(s_total);
+        step_metrics_on_step(now, s_total);
+        LOG_INF("step +1 (total=%u)", s_total);
+    }
+}
+
+/* 2) 抬腕手势：命中状态位再读手势输出，交给 wrist_wake 决定是否亮屏 */
+static void handle_wrist(uint16_t st)
+{
+    if (!(st & BMI270_WRIST_GEST_STATUS_MASK)) return;
+
+    uint8_t g = 0;
+    if (bmi270_read_wrist_gesture(&g) == 0) {
+        wrist_wake_on_gesture(g);
+    }
+}
+
+/* ========== 传感器上电配置：首次初始化与恢复共用 ========== */
+static int sensor_bringup(void)
+{
+    int ret = bmi270_steps_init();
+    if (ret) {
+        LOG_ERR("bmi270_steps_init failed: %d", ret);
+        return ret;
+    }
+
+    /* 运动状态特性失败不影响计步，只是不再自动降耗 */
+    (void)motion_state_init();
+    (void)wrist_wake_init();
+    return 0;
+}
+
+/* 清锁存并打开 INT1 边沿中断，进入 READY */
+static int int1_arm(void)
+{
+    /* 开中断前显式清一次锁存：初始化期间可能已有事件把 INT1 锁在高电平，
+     * 不清的话之后永远等不到上升沿 */
+    uint16_t st = 0;
+    (void)bmi270_steps_get_int_status(&st);
+
+    int ret = gpio_pin_interrupt_configure_dt(&s_int1, GPIO_INT_EDGE_TO_ACTIVE);
+    if (ret) {
+        LOG_ERR("INT1 interrupt configure failed: %d", ret);
+        return ret;
+    }
+
+    s_state = STEPS_ST_READY;
+    s_fail_streak = 0;
+    (void)k_work_reschedule_for_queue(sensor_wq(), &s_health_work, K_MSEC(STEPS_HEALTH_MS));
+
+    /* 清锁存与开中断之间若恰好来了事件，补一次处理 */
+    if (gpio_pin_get_dt(&s_int1) > 0) {
+        (void)k_work_reschedule_for_queue(sensor_wq(), &s_irq_work, K_NO_WAIT);
+    }
+    return 0;
+}
+
+static void enter_recover(const char *why)
+{
+    if (s_state == STEPS_ST_RECOVER) return;
+
+    s_state = STEPS_ST_RECOVER;
+    (void)gpio_pin_interrupt_configure_dt(&s_int1, GPIO_INT_DISABLE);
+    (void)k_work_cancel_delayable(&s_health_work);
+
+    LOG_WRN("sensor fault (%s), recover in %u ms", why, s_backoff_ms);
+    (void)k_work_reschedule_for_queue(sensor_wq(), &s_recover_work, K_MSEC(s_backoff_ms));
+}
+
+static void log_diag(void)
+{
+    struct bmi270_hal_stats hs;
+    bmi270_hal_get_stats(&hs);
+    LOG_INF("imu diag: comm_fail=%u retries=%u status_fail=%u bus_recover=%u inits=%u "
+            "recover=%u/%u health_fail=%u last_err=%d",
+            hs.comm_fail, hs.retries, hs.status_fail, hs.bus_recover, hs.inits,
+            s_health.recover_ok, s_health.recover_attempts, s_health.health_fail,
+            hs.last_err);
 }
-static struct gpio_callback s_cb;
 
-/* ========== 主线程入口：中断→判位→步数 & 抬腕 ========== */
-static void step_thread_entry(void *a, void *b, void *c)
+/* ========== 中断 work：一次状态读取处理一整波事件 ========== */
+static void irq_work_handler(struct k_work *work)
 {
-    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
+    ARG_UNUSED(work);
 
-    if (bmi270_steps_init() != 0) {
-        LOG_ERR("bmi270_steps_init failed");
+    if (s_state != STEPS_ST_READY) return;
+
+    uint16_t st = 0;
+    if (bmi270_steps_get_int_status(&st) != 0) {
+        if (++s_fail_streak >= STEPS_FAIL_LIMIT) {
+            enter_recover("int status");
+            return;
+        }
+        /* 没读成功锁存就没清，INT1 会一直保持高电平、不会再有新的上升沿，
+         * 必须自己再排一次，否则计步就此停住；隔一小段再读，瞬时毛刺不会连败到恢复 */
+        (void)k_work_reschedule_for_queue(sensor_wq(), &s_irq_work, K_MSEC(STEPS_RETRY_MS));
+        return;
+    }
+    s_fail_streak = 0;
+
+    handle_step(st);
+    handle_wrist(st);
+    motion_state_on_int(st);
+
+    /* 读状态时锁存已清；若此刻 INT1 仍为有效电平，说明读之后又锁存了新事件，
+     * 而它的上升沿可能被我们的读操作“吃掉”，这里补提交一次，保证不漏 */
+    if (gpio_pin_get_dt(&s_int1) > 0) {
+        (void)k_work_reschedule_for_queue(sensor_wq(), &s_irq_work, K_NO_WAIT);
+    }
+}
+
+/* ========== 恢复 work：总线恢复 → 重新初始化，失败则指数退避 ========== */
+static void recover_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    if (s_state != STEPS_ST_RECOVER) return;
+    s_health.recover_attempts++;
+
+    /* SDA 被从机拉住时所有事务都会失败，先释放总线；驱动不支持时忽略 */
+    (void)bmi270_bus_recover();
+
+    if (sensor_bringup() == 0 && int1_arm() == 0) {
+        s_health.recover_ok++;
+        s_backoff_ms = STEPS_BACKOFF_MIN_MS;
+        LOG_INF("sensor recovered (attempt %u)", s_health.recover_attempts);
+        log_diag();
+        return;
+    }
+
+    s_backoff_ms = MIN(s_backoff_ms * 2U, STEPS_BACKOFF_MAX_MS);
+    LOG_WRN("recover failed, retry in %u ms", s_backoff_ms);
+    (void)k_work_reschedule_for_queue(sensor_wq(), &s_recover_work, K_MSEC(s_backoff_ms));
+}
+
+/* ========== 健康检查 work：发现掉电复位/总线异常及时恢复，顺带打统计 ========== */
+static void health_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    if (s_state != STEPS_ST_READY) return;
+
+    if (bmi270_health_check() != 0) {
+        s_health.health_fail++;
+        enter_recover("health check");
         return;
     }
 
-    /* 配置 INT1：与设备树 irq-gpios=GPIO_ACTIVE_HIGH 对齐 → 上升沿触发 */
+    /* 兜底：INT1 停在有效电平却没有 work 在跑，说明丢了一个边沿 */
+    if (gpio_pin_get_dt(&s_int1) > 0) {
+        (void)k_work_reschedule_for_queue(sensor_wq(), &s_irq_work, K_NO_WAIT);
+    }
+
+    log_diag();
+    (void)k_work_reschedule_for_queue(sensor_wq(), &s_health_work, K_MSEC(STEPS_HEALTH_MS));
+}
+
+/* ========== 初始化 work：INT1 GPIO + BMI270 ========== */
+static void init_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    /* 配置 INT1：与设备树 irq-gpios=GPIO_ACTIVE_HIGH 对齐 → 上升沿触发
+     * GPIO 侧的错误属于配置问题，恢复也无济于事，直接停在 IDLE */
     if (!device_is_ready(s_int1.port)) {
         LOG_ERR("INT1 port not ready");
+        s_state = STEPS_ST_IDLE;
         return;
     }
 
@@ -73,6 +285,7 @@ static void step_thread_entry(void *a, void *b, void *c)
     ret = gpio_pin_configure_dt(&s_int1, GPIO_INPUT);
     if (ret) {
         LOG_ERR("INT1 configure failed: %d", ret);
+        s_state = STEPS_ST_IDLE;
         return;
     }
 
@@ -82,62 +295,36 @@ static void step_thread_entry(void *a, void *b, void *c)
     ret = gpio_add_callback(s_int1.port, &s_cb);
     if (ret) {
         LOG_ERR("INT1 add callback failed: %d", ret);
+        s_state = STEPS_ST_IDLE;
         return;
     }
 
-    ret = gpio_pin_interrupt_configure_dt(&s_int1, GPIO_INT_EDGE_TO_ACTIVE);
-    if (ret) {
-        LOG_ERR("INT1 interrupt configure failed: %d", ret);
+    /* 传感器侧失败（没焊好/上电慢/总线卡住）交给恢复流程重试，不再永久放弃 */
+    if (sensor_bringup() != 0 || int1_arm() != 0) {
+        enter_recover("init");
         return;
     }
+    LOG_INF("INT1 ready (latched, edge-to-active)");
+}
 
-    LOG_INF("INT1 ready (edge-to-active)");
-
-    uint32_t total = 0;
-    int64_t  last_step_ms = -100000;
-
-    while (1) {
-        /* 合并“边沿风暴”：先取一次，再把短时间多余 token 清空 */
-        k_sem_take(&s_irq_sem, K_FOREVER);
-        while (k_sem_take(&s_irq_sem, K_NO_WAIT) == 0) { /* drain */ }
-
-        uint16_t st = 0;
-        if (bmi270_steps_get_int_status(&st) != 0) {
-            continue;
-        }
+/* ========== 对外接口 ========== */
+int steps_service_start(void)
+{
+    if (s_state != STEPS_ST_IDLE) return -EALREADY;
 
-        /* 1) 单步事件（这版 SDK 中 Detector/Counter 共用 0x02 状态位） */
-        if (st & BMI270_STEP_CNT_STATUS_MASK) {
-            int64_t now = k_uptime_get();
-            if ((now - last_step_ms) >= MIN_STEP_MS) {
-                last_step_ms = now;
-                total++;
-                publish_steps(total);
-                LOG_INF("step +1 (total=%u)", total);
-            }
-        }
+    k_work_init(&s_init_work, init_work_handler);
+    k_work_init_delayable(&s_irq_work, irq_work_handler);
+    k_work_init_delayable(&s_recover_work, recover_work_handler);
+    k_work_init_delayable(&s_health_work, health_work_handler);
 
-        /* 2) 抬腕手势：命中状态位再读手势输出，pivot_up(=2) 则亮屏 */
-
-        if (st & BMI270_WRIST_GEST_STATUS_MASK) {
-            uint8_t g = 0;
-            if (bmi270_read_wrist_gesture(&g) == 0 && g == 2 /* pivot_up */) {
-                /* 如果屏幕没有亮 */
-                if (!blctl_is_awake()) {
-                    blctl_wake();
-                }          
-                LOG_INF("wrist pivot_up -> wake");
-            }
-        }
-    }
+    s_state = STEPS_ST_INIT;
+    (void)k_work_submit_to_queue(sensor_wq(), &s_init_work);
+    return 0;
 }
 
-/* ========== 对外启动入口 ========== */
-int steps_service_start(void)
+void steps_service_get_health(struct steps_health *out)
 {
-    k_thread_create(&step_thread, step_stack, STEP_STACK,
-                    step_thread_entry, NULL, NULL, NULL,
-                    STEP_PRIO, 0, K_NO_WAIT);
-    k_thread_name_set(&step_thread, "steps");
-    return 0;
+    if (!out) return;
+    *out = s_health;
+    out->state = (uint8_t)s_state;
 }
@@ -1,6 +1,15 @@
 // sensor/app_bmi270_steps.h
 #pragma once
+#include <stdint.h>
 
 
+int steps_service_start(void);
 
-int steps_service_start(void);
\ No newline at end of file
+/* 恢复状态机的统计（HAL 层通信统计见 bmi270_hal_get_stats） */
+struct steps_health {
+    uint8_t  state;             /* 0=IDLE 1=INIT 2=READY 3=RECOVER */
+    uint32_t recover_attempts;
+    uint32_t recover_ok;
+    uint32_t health_fail;       /* 健康检查发现芯片复位/失联 */
+};
+void steps_service_get_health(struct steps_health *out);
@@ -0,0 +1,272 @@
+#include "wrist_wake.h"
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(wrist_wake, LOG_LEVEL_INF);
+
+#if IS_ENABLED(CONFIG_SETTINGS)
+#include <zephyr/settings/settings.h>
+#endif
+
+#include "bmi270_hal.h"
+#include "sensor_wq.h"
+#include "app/backlight_ctrl.h"
+#include "app/settings_cache.h"
+
+/* 屏幕法向在 IMU 坐标系里的轴和方向（按板子贴片方向改） */
+#ifndef WWAKE_FACE_AXIS
+#define WWAKE_FACE_AXIS           2          /* 0=X 1=Y 2=Z */
+#endif
+#ifndef WWAKE_FACE_SIGN
+#define WWAKE_FACE_SIGN           1          /* 朝上时该轴读数为正则 1，否则 -1 */
+#endif
+
+/* 陀螺仪确认窗口：开机建立时间 + N 次采样 */
+#ifndef WWAKE_GYR_SETTLE_MS
+#define WWAKE_GYR_SETTLE_MS       45         /* 100Hz 下约 4 个样本后数据稳定 */
+#endif
+#ifndef WWAKE_GYR_SAMPLE_MS
+#define WWAKE_GYR_SAMPLE_MS       10
+#endif
+#ifndef WWAKE_GYR_SAMPLES
+#define WWAKE_GYR_SAMPLES         8
+#endif
+
+/* 配置：任意线程改，sensor_wq 读；用自旋锁整体拷贝 */
+static struct k_spinlock s_lock;
+static struct wrist_wake_cfg s_cfg = {
+    .mode           = WWAKE_MODE_DEFAULT,
+    .arm            = WWAKE_ARM_DEFAULT,
+    .min_face_up_mg = WWAKE_FACE_UP_MG_DEFAULT,
+    .max_rate_dps   = WWAKE_MAX_RATE_DPS_DEFAULT,
+};
+static struct wrist_wake_stats s_stats;
+
+/* 以下只在 sensor_wq 上访问 */
+static bool  s_ready;
+static bool  s_confirming;
+static uint8_t s_ok_cnt;
+static uint8_t s_sample_cnt;
+static struct wrist_wake_cfg s_run_cfg;   /* 本轮确认用的配置快照 */
+
+/* 静态定义：settings commit 可能早于 wrist_wake_init 提交 apply */
+static void apply_work_handler(struct k_work *work);
+static void confirm_work_handler(struct k_work *work);
+static K_WORK_DEFINE(s_apply_work, apply_work_handler);
+static K_WORK_DELAYABLE_DEFINE(s_confirm_work, confirm_work_handler);
+
+static void cfg_snapshot(struct wrist_wake_cfg *out)
+{
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    *out = s_cfg;
+    k_spin_unlock(&s_lock, key);
+}
+
+static void cfg_sanitize(struct wrist_wake_cfg *c)
+{
+    if (c->mode > WWAKE_MODE_GYRO) c->mode = WWAKE_MODE_DEFAULT;
+    c->arm            = c->arm ? 1 : 0;
+    c->min_face_up_mg = CLAMP(c->min_face_up_mg, 0, 1000);
+    c->max_rate_dps   = CLAMP(c->max_rate_dps, 10, 1000);
+}
+
+/* ==== settings：/wwake/cfg，整块保存 ==== */
+#if IS_ENABLED(CONFIG_SETTINGS)
+static int wwake_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+                              void *cb_arg)
+{
+    if (!strcmp(name, "cfg") && len == sizeof(struct wrist_wake_cfg)) {
+        struct wrist_wake_cfg c;
+        if (read_cb(cb_arg, &c, sizeof(c)) != sizeof(c)) return -EIO;
+        settings_cache_seed("wwake/cfg", &c, sizeof(c));
+        cfg_sanitize(&c);
+
+        k_spinlock_key_t key = k_spin_lock(&s_lock);
+        s_cfg = c;
+        k_spin_unlock(&s_lock, key);
+        return 0;
+    }
+    return -ENOENT;
+}
+
+/* settings_load 可能晚于 BMI270 初始化，加载完再下发一次 */
+static int wwake_settings_commit(void)
+{
+    (void)k_work_submit_to_queue(sensor_wq(), &s_apply_work);
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(wwake, "wwake", NULL, wwake_settings_set,
+                               wwake_settings_commit, NULL);
+
+static inline void wwake_save(const struct wrist_wake_cfg *c)
+{
+    (void)settings_cache_put("wwake/cfg", c, sizeof(*c));
+}
+#else
+static inline void wwake_save(const struct wrist_wake_cfg *c) { ARG_UNUSED(c); }
+#endif
+
+static void apply_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+    if (!s_ready) return;
+
+    struct wrist_wake_cfg c;
+    cfg_snapshot(&c);
+    if (bmi270_set_wrist_arm(c.arm) != 0) {
+        LOG_WRN("set wrist arm failed");
+    }
+}
+
+/* 屏幕是否朝上：法向轴重力分量 >= 阈值 */
+static bool face_up(const struct bmi270_motion_sample *s, uint16_t min_mg)
+{
+    int32_t mg = (int32_t)s->acc[WWAKE_FACE_AXIS] * WWAKE_FACE_SIGN * 1000 /
+                 BMI270_ACC_LSB_PER_G;
+    return mg >= (int32_t)min_mg;
+}
+
+/* 角速度模长是否低于阈值：比较平方，避免开方；int64 防溢出 */
+static bool rate_settled(const struct bmi270_motion_sample *s, uint16_t max_dps)
+{
+    int64_t lim = (int64_t)max_dps * BMI270_GYR_LSB_PER_KDPS / 1000;
+    int64_t sq  = (int64_t)s->gyr[0] * s->gyr[0] +
+                  (int64_t)s->gyr[1] * s->gyr[1] +
+                  (int64_t)s->gyr[2] * s->gyr[2];
+    return sq <= lim * lim;
+}
+
+static void do_wake(void)
+{
+    s_stats.wakes++;
+    if (!blctl_is_awake()) {
+        blctl_wake();
+    }
+}
+
+static void do_reject(const char *why)
+{
+    s_stats.rejects++;
+    LOG_INF("wrist pivot_up rejected (%s), rejects=%u", why, s_stats.rejects);
+}
+
+/* GYRO 模式：开陀螺仪后每 WWAKE_GYR_SAMPLE_MS 采一次，多数票通过即亮屏 */
+static void confirm_work_handler(struct k_work *work)
+{
+    ARG_UNUSED(work);
+
+    struct bmi270_motion_sample s;
+    if (bmi270_read_motion_sample(&s) == 0) {
+        if (face_up(&s, s_run_cfg.min_face_up_mg) &&
+            rate_settled(&s, s_run_cfg.max_rate_dps)) {
+            s_ok_cnt++;
+        }
+    }
+    s_sample_cnt++;
+
+    /* 已过半则提前结束，少开一会儿陀螺仪 */
+    bool pass = s_ok_cnt > WWAKE_GYR_SAMPLES / 2;
+    bool fail = (s_sample_cnt - s_ok_cnt) >= (WWAKE_GYR_SAMPLES + 1) / 2;
+
+    if (!pass && !fail && s_sample_cnt < WWAKE_GYR_SAMPLES) {
+        (void)k_work_reschedule_for_queue(sensor_wq(), &s_confirm_work,
+                                          K_MSEC(WWAKE_GYR_SAMPLE_MS));
+        return;
+    }
+
+    (void)bmi270_set_gyro(false);
+    s_confirming = false;
+
+    if (pass) {
+        do_wake();
+        LOG_INF("wrist pivot_up confirmed by gyro (%u/%u)", s_ok_cnt, s_sample_cnt);
+    } else {
+        do_reject("gyro");
+    }
+}
+
+int wrist_wake_init(void)
+{
+    s_ready = true;
+    apply_work_handler(&s_apply_work);
+    return 0;
+}
+
+void wrist_wake_on_gesture(uint8_t gesture)
+{
+    if (gesture != 2 /* pivot_up */) return;
+    s_stats.gestures++;
+
+    if (s_confirming) return;   /* 上一轮确认还没结束，合并 */
+
+    struct wrist_wake_cfg c;
+    cfg_snapshot(&c);
+
+    switch (c.mode) {
+    case WWAKE_MODE_OFF:
+        return;
+
+    case WWAKE_MODE_GESTURE:
+        do_wake();
+        LOG_INF("wrist pivot_up -> wake");
+        return;
+
+    case WWAKE_MODE_TILT: {
+        struct bmi270_motion_sample s;
+        /* 读失败时宁可亮屏，避免“抬腕不亮” */
+        if (bmi270_read_motion_sample(&s) != 0 || face_up(&s, c.min_face_up_mg)) {
+            do_wake();
+            LOG_INF("wrist pivot_up + tilt -> wake");
+        } else {
+            do_reject("tilt");
+        }
+        return;
+    }
+
+    case WWAKE_MODE_GYRO:
+    default:
+        if (bmi270_set_gyro(true) != 0) {
+            /* 陀螺仪开不起来就退化为手势直通 */
+            do_wake();
+            return;
+        }
+        s_run_cfg    = c;
+        s_ok_cnt     = 0;
+        s_sample_cnt = 0;
+        s_confirming = true;
+        (void)k_work_reschedule_for_queue(sensor_wq(), &s_confirm_work,
+                                          K_MSEC(WWAKE_GYR_SETTLE_MS));
+        return;
+    }
+}
+
+int wrist_wake_set_cfg(const struct wrist_wake_cfg *cfg)
+{
+    if (!cfg) return -EINVAL;
+
+    struct wrist_wake_cfg c = *cfg;
+    cfg_sanitize(&c);
+
+    k_spinlock_key_t key = k_spin_lock(&s_lock);
+    s_cfg = c;
+    k_spin_unlock(&s_lock, key);
+
+    wwake_save(&c);
+    (void)k_work_submit_to_queue(sensor_wq(), &s_apply_work);
+    LOG_INF("cfg: mode=%u arm=%u face_up=%umg rate<%udps",
+            c.mode, c.arm, c.min_face_up_mg, c.max_rate_dps);
+    return 0;
+}
+
+void wrist_wake_get_cfg(struct wrist_wake_cfg *out)
+{
+    if (out) cfg_snapshot(out);
+}
+
+void wrist_wake_get_stats(struct wrist_wake_stats *out)
+{
+    if (out) *out = s_stats;
+}
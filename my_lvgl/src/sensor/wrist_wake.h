@@ -0,0 +1,56 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 抬腕亮屏引擎：
+ *  - GESTURE：只看 BMI270 wrist gesture 的 pivot_up（原行为）
+ *  - TILT   ：手势 + 一次 ACC 读取，确认屏幕朝上才亮
+ *  - GYRO   ：手势 + 短时开陀螺仪采一段窗口，朝上且转速已稳定（在看表）才亮，
+ *             甩手/走路摆臂产生的手势会被拒掉
+ * 缺省仍是 GESTURE（与原行为一致）；TILT/GYRO 需经 BLE（ble_proto_wwake）或 settings 显式打开。
+ * 配置运行时可改，并持久化到 settings "wwake/cfg"
+ */
+enum wrist_wake_mode {
+    WWAKE_MODE_OFF = 0,
+    WWAKE_MODE_GESTURE,
+    WWAKE_MODE_TILT,
+    WWAKE_MODE_GYRO,
+};
+
+struct wrist_wake_cfg {
+    uint8_t  mode;            /* enum wrist_wake_mode */
+    uint8_t  arm;             /* 0=左手 1=右手（BMI2_ARM_LEFT/RIGHT） */
+    uint16_t min_face_up_mg;  /* 屏幕法向轴上至少这么多重力分量才算“朝上” */
+    uint16_t max_rate_dps;    /* GYRO 模式：角速度模长低于该值才算“已停稳” */
+};
+
+struct wrist_wake_stats {
+    uint32_t gestures;        /* 收到的 pivot_up 次数 */
+    uint32_t wakes;           /* 实际亮屏次数 */
+    uint32_t rejects;         /* 被倾角/陀螺仪确认拒掉的次数 */
+};
+
+/* 缺省值，可在编译时 -D 覆盖 */
+#ifndef WWAKE_MODE_DEFAULT
+#define WWAKE_MODE_DEFAULT        WWAKE_MODE_GESTURE
+#endif
+#ifndef WWAKE_ARM_DEFAULT
+#define WWAKE_ARM_DEFAULT         0          /* 左手 */
+#endif
+#ifndef WWAKE_FACE_UP_MG_DEFAULT
+#define WWAKE_FACE_UP_MG_DEFAULT  500        /* ≈ 与水平面夹角 < 60° */
+#endif
+#ifndef WWAKE_MAX_RATE_DPS_DEFAULT
+#define WWAKE_MAX_RATE_DPS_DEFAULT 120
+#endif
+
+/* BMI270 初始化成功后调用（sensor_wq 上下文）：下发佩戴手 */
+int  wrist_wake_init(void);
+
+/* 步数服务读到 wrist gesture 输出后转交（sensor_wq 上下文） */
+void wrist_wake_on_gesture(uint8_t gesture);
+
+/* 任意线程可调：set 会校验/夹取后保存，并在 sensor_wq 上重新下发 */
+int  wrist_wake_set_cfg(const struct wrist_wake_cfg *cfg);
+void wrist_wake_get_cfg(struct wrist_wake_cfg *out);
+void wrist_wake_get_stats(struct wrist_wake_stats *out);
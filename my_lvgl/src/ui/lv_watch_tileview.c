@@ -39,6 +39,21 @@ static void watch_tileview_tile_constructor(const lv_obj_class_t * class_p, lv_o
 static lv_obj_t * watch_tileview_add_tile(lv_obj_t * obj, uint8_t col_id, uint8_t row_id, lv_dir_t dir);
 static void watch_tileview_adjust_main_rotate(lv_obj_t * obj, lv_anim_enable_t anim_en);
 
+static void watch_tileview_update_residency(lv_obj_t * obj, bool prefetch);
+static void watch_tileview_build_visible(lv_obj_t * obj);
+static void watch_tileview_residency_timer_cb(lv_timer_t * t);
+
+static void watch_tileview_tile_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
+static void watch_tileview_tile_event_cb(const lv_obj_class_t * class_p, lv_event_t * e);
+static void watch_tileview_snap_begin(lv_obj_t * obj);
+static void watch_tileview_snap_end(lv_obj_t * obj);
+static void watch_tileview_snap_drop(watch_tileview_t * tv, watch_tileview_tile_t * tile);
+
+/* 顶层子控件上的快照标志 USER_1：滑动期间被我们临时隐藏；USER_2：实时绘制，不进快照 */
+#define SNAP_FLAG_HIDDEN	LV_OBJ_FLAG_USER_1
+#define SNAP_FLAG_LIVE		LV_OBJ_FLAG_USER_2
+static void watch_tileview_snap_disp_event_cb(lv_event_t * e);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -54,6 +69,8 @@ const lv_obj_class_t watch_tileview_class = {
 
 const lv_obj_class_t watch_tileview_tile_class ={
 	.constructor_cb = watch_tileview_tile_constructor,
+	.destructor_cb = watch_tileview_tile_destructor,
+	.event_cb = watch_tileview_tile_event_cb,
 	.width_def = LV_PCT(100),
 	.height_def = LV_PCT(100),
 	.base_class = &lv_obj_class,
@@ -152,6 +169,7 @@ lv_result_t watch_tileview_set_tile(lv_obj_t * obj, lv_obj_t * tile_obj, lv_anim
 	if (lv_obj_is_scrolling(obj))
 		return LV_RESULT_INVALID;
 
+	watch_tileview_snap_end(obj);
 	lv_obj_update_snap(obj, LV_ANIM_OFF);
 	lv_indev_wait_release(lv_indev_get_next(NULL));
 
@@ -204,6 +222,8 @@ lv_result_t watch_tileview_set_tile(lv_obj_t * obj, lv_obj_t * tile_obj, lv_anim
 	/* 4) adjust for main rotate */
 	watch_tileview_adjust_main_rotate(obj, LV_ANIM_OFF);
 
+	watch_tileview_update_residency(obj, false);
+
 	return LV_RESULT_OK;
 }
 
@@ -238,6 +258,99 @@ void watch_tileview_set_start_tile(lv_obj_t* obj, lv_obj_t* tile_obj)
     }
 
     bypass_scroll_event = false;
+
+    /* 起始页马上建好，相邻页等首帧之后再预建 */
+    watch_tileview_update_residency(obj, false);
+}
+
+void watch_tileview_set_tile_factory(lv_obj_t * obj, lv_obj_t * tile_obj,
+									 watch_tileview_build_cb_t build_cb,
+									 watch_tileview_free_cb_t free_cb,
+									 void * user_data, uint32_t est_bytes)
+{
+	watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tile_obj;
+
+	LV_ASSERT(build_cb != NULL && lv_obj_get_child_count(tile_obj) == 0);
+
+	tile->build_cb = build_cb;
+	tile->free_cb = free_cb;
+	tile->user_data = user_data;
+	tile->cost = est_bytes;
+	tile->built = 0;
+
+	/* 已经有活动页（运行中追加工厂）时按当前位置补建 */
+	if (((watch_tileview_t *)obj)->tile_act)
+		watch_tileview_update_residency(obj, false);
+}
+
+void watch_tileview_pin_tile(lv_obj_t * tile_obj, bool pinned)
+{
+	((watch_tileview_tile_t *)tile_obj)->pinned = pinned;
+}
+
+void watch_tileview_set_tile_snapshot(lv_obj_t * tile_obj, bool en)
+{
+	watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tile_obj;
+	lv_obj_t *obj = lv_obj_get_parent(tile_obj);
+	watch_tileview_t *tv = (watch_tileview_t *)obj;
+
+	if (WATCH_TILEVIEW_SNAP_BUDGET == 0 || tile->snap_en == en)
+		return;
+
+	if (!en) {
+		watch_tileview_snap_drop(tv, tile);
+		lv_free(tile->snap);
+		tile->snap = NULL;
+		tile->snap_en = 0;
+		return;
+	}
+
+	tile->snap = lv_malloc_zeroed(sizeof(watch_tileview_snap_rect_t) * WATCH_TILEVIEW_SNAP_RECTS);
+	if (tile->snap == NULL)
+		return;
+	tile->snap_en = 1;
+
+	/* 内容变化靠显示器的失效区域发现：落在已缓存页上的重绘让快照作废 */
+	if (tv->snap_disp == NULL) {
+		tv->snap_disp = lv_obj_get_display(obj);
+		lv_display_add_event_cb(tv->snap_disp, watch_tileview_snap_disp_event_cb,
+								LV_EVENT_INVALIDATE_AREA, obj);
+	}
+}
+
+void watch_tileview_invalidate_snapshot(lv_obj_t * obj)
+{
+	/* 往上找到所在的页；途中遇到实时绘制的控件说明它不在快照里 */
+	while (obj && !lv_obj_check_type(obj, &watch_tileview_tile_class)) {
+		if (lv_obj_has_flag(obj, SNAP_FLAG_LIVE))
+			return;
+		obj = lv_obj_get_parent(obj);
+	}
+	if (obj == NULL)
+		return;
+
+	watch_tileview_tile_t *tile = (watch_tileview_tile_t *)obj;
+	if (!tile->snap_valid)
+		return;
+	/* 正贴在屏上的快照不能现在释放，记下来停稳时再丢 */
+	if (tile->snap_shown)
+		tile->snap_stale = 1;
+	else
+		watch_tileview_snap_drop((watch_tileview_t *)lv_obj_get_parent(obj), tile);
+}
+
+void watch_tileview_set_live(lv_obj_t * obj, bool live)
+{
+	lv_obj_t *tile_obj = lv_obj_get_parent(obj);
+
+	if (live)
+		lv_obj_add_flag(obj, SNAP_FLAG_LIVE);
+	else
+		lv_obj_remove_flag(obj, SNAP_FLAG_LIVE);
+
+	/* 快照里是否含这个控件变了 */
+	if (tile_obj && lv_obj_check_type(tile_obj, &watch_tileview_tile_class))
+		watch_tileview_invalidate_snapshot(tile_obj);
 }
 
 
@@ -261,11 +374,19 @@ static void watch_tileview_constructor(const lv_obj_class_t * class_p, lv_obj_t
 	lv_style_init(&tv->style);
 	lv_style_set_bg_color(&tv->style, lv_color_black());
 	lv_style_set_bg_opa(&tv->style, LV_OPA_COVER);
+
+	tv->residency_timer = lv_timer_create(watch_tileview_residency_timer_cb,
+										  WATCH_TILEVIEW_EVICT_MS, obj);
+	lv_timer_pause(tv->residency_timer);
 }
 
 static void watch_tileview_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
 	watch_tileview_t *tv = (watch_tileview_t *)obj;
+	if (tv->snap_disp)
+		lv_display_remove_event_cb_with_user_data(tv->snap_disp,
+												  watch_tileview_snap_disp_event_cb, obj);
+	lv_timer_delete(tv->residency_timer);
 	lv_style_reset(&tv->style);
 }
 
@@ -275,6 +396,16 @@ static void watch_tileview_tile_constructor(const lv_obj_class_t * class_p, lv_o
 
 	lv_obj_update_layout(obj);
 	tile->dir = create_dir;
+	tile->built = 1;            /* 没登记工厂的页：内容由调用方直接创建，常驻 */
+}
+
+static void watch_tileview_tile_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
+{
+	watch_tileview_tile_t *tile = (watch_tileview_tile_t *)obj;
+
+	/* 子对象先于父对象析构，此时 tileview 还在 */
+	watch_tileview_snap_drop((watch_tileview_t *)lv_obj_get_parent(obj), tile);
+	lv_free(tile->snap);
 }
 
 static lv_obj_t * watch_tileview_add_tile(lv_obj_t * obj, uint8_t col_id, uint8_t row_id, lv_dir_t dir)
@@ -307,6 +438,42 @@ static lv_obj_t * watch_tileview_add_tile(lv_obj_t * obj, uint8_t col_id, uint8_
 
 
 
+/* 主轴所有页（子对象 0..main_cnt-1）连同滚动位置整体平移 shift 列 */
+static void watch_tileview_ring_shift(lv_obj_t * obj, int32_t shift, int32_t step,
+									  lv_dir_t main_dir, lv_point_t * scroll_end)
+{
+	watch_tileview_t *tv = (watch_tileview_t *)obj;
+	int32_t d = shift * step;
+
+	for (int i = 0; i < tv->main_cnt; i++) {
+		lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
+		if (main_dir == LV_DIR_HOR)
+			lv_obj_set_x(tile_obj, lv_obj_get_style_x(tile_obj, 0) + d);
+		else
+			lv_obj_set_y(tile_obj, lv_obj_get_style_y(tile_obj, 0) + d);
+	}
+	/* 滚动范围按子对象的实际坐标算，先刷新布局，否则 scroll_to 会被旧范围截断 */
+	lv_obj_update_layout(obj);
+
+	if (main_dir == LV_DIR_HOR) {
+		lv_obj_scroll_to_x(obj, lv_obj_get_scroll_x(obj) + d, LV_ANIM_OFF);
+		scroll_end->x += d;
+	}
+	else {
+		lv_obj_scroll_to_y(obj, lv_obj_get_scroll_y(obj) + d, LV_ANIM_OFF);
+		scroll_end->y += d;
+	}
+	tv->ring_origin += shift;
+}
+
+/*
+ * 环形主轴：主轴页的子对象下标固定不变，第 k 页在第
+ *   ring_origin + (k - ring_head) mod main_cnt
+ * 列。滑到任一端时只把另一端那一页搬过来接上，其余页和滚动位置都不动；
+ * 横向页只在中心页被搬动时跟着挪。
+ * LVGL 不能往负坐标滚，所以 ring_origin 保持在 [0, 2 * RING_RENORM]：
+ * 碰到边界时把整条主轴平移 RING_RENORM 列，这一次是 O(页数)，均摊仍是 O(1)。
+ */
 static void watch_tileview_adjust_main_rotate(lv_obj_t * obj, lv_anim_enable_t anim_en)
 {
 	watch_tileview_t *tv = (watch_tileview_t *)obj;
@@ -316,18 +483,23 @@ static void watch_tileview_adjust_main_rotate(lv_obj_t * obj, lv_anim_enable_t a
 	if (!tv->main_rotated || !(lv_obj_get_scroll_dir(obj) & main_dir))
 		return;
 
-    int32_t content_w = lv_obj_get_content_width(obj);
-    int32_t content_h = lv_obj_get_content_height(obj);
-    int32_t scroll_x_max = content_w * (tv->main_cnt - 1);
-    int32_t scroll_y_max = content_h * (tv->main_cnt - 1);
-	lv_obj_t *adjusted_main = NULL;
-	int i;
+	int32_t step = (main_dir == LV_DIR_HOR) ? lv_obj_get_content_width(obj)
+											: lv_obj_get_content_height(obj);
+	lv_obj_t *adjusted_main;
+	uint8_t moved;
+	int32_t col;
 
 	lv_point_t scroll_end;
 	lv_obj_get_scroll_end(obj, &scroll_end);
 
-	if ((main_dir == LV_DIR_HOR && scroll_end.x > 0 && scroll_end.x < scroll_x_max) ||
-		(main_dir != LV_DIR_HOR && scroll_end.y > 0 && scroll_end.y < scroll_y_max))
+	int32_t end_col = ((main_dir == LV_DIR_HOR) ? scroll_end.x : scroll_end.y) / step;
+	int32_t shift = 0;
+
+	if (end_col == tv->ring_origin)
+		shift = (tv->ring_origin == 0) ? WATCH_TILEVIEW_RING_RENORM : 0;
+	else if (end_col == tv->ring_origin + tv->main_cnt - 1)
+		shift = (tv->ring_origin >= 2 * WATCH_TILEVIEW_RING_RENORM) ? -WATCH_TILEVIEW_RING_RENORM : 0;
+	else
 		return;
 
 	bypass_scroll_event = true;
@@ -338,84 +510,43 @@ static void watch_tileview_adjust_main_rotate(lv_obj_t * obj, lv_anim_enable_t a
 		lv_obj_set_pos(tv->tile_center, tv->scroll_center.x, tv->scroll_center.y);
 	}
 
-	if (main_dir == LV_DIR_HOR) {
-		if (scroll_end.x == 0) {
-			for (i = 0; i < tv->main_cnt - 1; i++) {
-				lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
-				if (tile_obj) {
-					lv_obj_set_x(tile_obj, (i + 1) * content_w);
-				}
-			}
-
-			adjusted_main = lv_obj_get_child(obj, tv->main_cnt - 1);
-			if (adjusted_main) {
-				lv_obj_set_x(adjusted_main, 0);
-				lv_obj_move_to_index(adjusted_main, 0);
-				lv_obj_scroll_to_x(obj, lv_obj_get_scroll_x(obj) + content_w, LV_ANIM_OFF);
-				scroll_end.x += content_w;
-			}
-		}
-		else if (scroll_end.x == scroll_x_max) {
-			for (i = 1; i < tv->main_cnt; i++) {
-				lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
-				if (tile_obj)
-					lv_obj_set_x(tile_obj, (i - 1) * content_w);
-			}
-
-			adjusted_main = lv_obj_get_child(obj, 0);
-			if (adjusted_main) {
-				lv_obj_set_x(adjusted_main, scroll_x_max);
-				lv_obj_move_to_index(adjusted_main, tv->main_cnt - 1);
-				lv_obj_scroll_to_x(obj, lv_obj_get_scroll_x(obj) - content_w, LV_ANIM_OFF);
-				scroll_end.x -= content_w;
-			}
-		}
-
-		tv->scroll_center.x = lv_obj_get_style_x(tv->tile_center, 0);
+	if (shift) {
+		watch_tileview_ring_shift(obj, shift, step, main_dir, &scroll_end);
+		end_col += shift;
+	}
 
-		for (i = tv->main_cnt; i < lv_obj_get_child_cnt(obj); i++) {
-			lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
-			if (tile_obj)
-				lv_obj_set_x(tile_obj, tv->scroll_center.x);
-		}
+	if (end_col == tv->ring_origin) {
+		/* 到了最前一列：最后一页搬到它前面 */
+		moved = (tv->ring_head + tv->main_cnt - 1) % tv->main_cnt;
+		tv->ring_head = moved;
+		tv->ring_origin--;
+		col = tv->ring_origin;
 	}
 	else {
-		if (scroll_end.y == 0) {
-			for (i = 0; i < tv->main_cnt - 1; i++) {
-				lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
-				if (tile_obj)
-					lv_obj_set_y(tile_obj, (i + 1) * content_h);
-			}
-
-			adjusted_main = lv_obj_get_child(obj, tv->main_cnt - 1);
-			if (adjusted_main) {
-				lv_obj_set_y(adjusted_main, 0);
-				lv_obj_move_to_index(adjusted_main, 0);
-				lv_obj_scroll_to_y(obj, lv_obj_get_scroll_y(obj) + content_h, LV_ANIM_OFF);
-				scroll_end.y += content_h;
-			}
-		}
-		else if (scroll_end.y == scroll_y_max) {
-			for (i = 1; i < tv->main_cnt; i++) {
-				lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
-				if (tile_obj)
-					lv_obj_set_y(tile_obj, (i - 1) * content_h);
-			}
+		/* 到了最后一列：最前一页搬到它后面 */
+		moved = tv->ring_head;
+		tv->ring_head = (tv->ring_head + 1) % tv->main_cnt;
+		col = tv->ring_origin + tv->main_cnt;
+		tv->ring_origin++;
+	}
 
-			adjusted_main = lv_obj_get_child(obj, 0);
-			if (adjusted_main) {
-				lv_obj_set_y(adjusted_main, scroll_y_max);
-				lv_obj_move_to_index(adjusted_main, tv->main_cnt - 1);
-				lv_obj_scroll_to_y(obj, lv_obj_get_scroll_y(obj) - content_h, LV_ANIM_OFF);
-				scroll_end.y -= content_h;
-			}
-		}
+	adjusted_main = lv_obj_get_child(obj, moved);
+	if (main_dir == LV_DIR_HOR)
+		lv_obj_set_x(adjusted_main, col * step);
+	else
+		lv_obj_set_y(adjusted_main, col * step);
 
-		tv->scroll_center.y = lv_obj_get_style_y(tv->tile_center, 0);
+	if ((shift || adjusted_main == tv->tile_center) && tv->tile_center) {
+		if (main_dir == LV_DIR_HOR)
+			tv->scroll_center.x = lv_obj_get_style_x(tv->tile_center, 0);
+		else
+			tv->scroll_center.y = lv_obj_get_style_y(tv->tile_center, 0);
 
-		for (i = tv->main_cnt; i < lv_obj_get_child_cnt(obj); i++) {
+		for (int i = tv->main_cnt; i < lv_obj_get_child_cnt(obj); i++) {
 			lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
-			if (tile_obj)
+			if (main_dir == LV_DIR_HOR)
+				lv_obj_set_x(tile_obj, tv->scroll_center.x);
+			else
 				lv_obj_set_y(tile_obj, tv->scroll_center.y);
 		}
 	}
@@ -473,6 +604,8 @@ static void watch_tileview_event_cb(const lv_obj_class_t * class_p, lv_event_t *
 			 * result in cross scrolling while the anim scroling still go on.
 			 */
 			lv_obj_set_scroll_dir(obj, dir);
+
+			watch_tileview_snap_begin(obj);
 		}
 	}
 	else if (code == LV_EVENT_SCROLL_END) {
@@ -511,6 +644,8 @@ static void watch_tileview_event_cb(const lv_obj_class_t * class_p, lv_event_t *
 		/* handle rotate mode */
 		    watch_tileview_adjust_main_rotate(obj, LV_ANIM_ON);
 
+		watch_tileview_update_residency(obj, false);
+
 		/*
 		 * Maybe still scrolling by pressing when previous anim scrolling end,
 		 * since anim scrolling will not stopped before pressing scrolling.
@@ -527,9 +662,450 @@ static void watch_tileview_event_cb(const lv_obj_class_t * class_p, lv_event_t *
 			watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tv->tile_act;
 
 			lv_obj_set_scroll_dir(obj, tile->dir);
+
+			/* 停稳了，换回真实控件 */
+			watch_tileview_snap_end(obj);
 		}
 	}
 	else if (code == LV_EVENT_SCROLL) {
-		lv_dir_t dir = lv_obj_get_scroll_dir(obj);
+		/* 相邻页一般已预建；预建还没轮到就开始滑时，在露出的第一帧补建 */
+		watch_tileview_build_visible(obj);
+	}
+}
+
+/*=====================
+ * Lazy tile content
+ *====================*/
+
+/* 页的逻辑位置：浮动中的中心页实际摆在 (0,0)，按它原本的位置算 */
+static void tile_logical_pos(watch_tileview_t * tv, lv_obj_t * tile_obj, lv_point_t * p)
+{
+	if (tile_obj == tv->tile_center && lv_obj_has_flag(tile_obj, LV_OBJ_FLAG_FLOATING)) {
+		*p = tv->scroll_center;
+	}
+	else {
+		p->x = lv_obj_get_x(tile_obj);
+		p->y = lv_obj_get_y(tile_obj);
+	}
+}
+
+/* 活动页本身或与之上下/左右相邻（下一次滑动就会露出来） */
+static bool tile_is_near(watch_tileview_t * tv, lv_obj_t * tile_obj)
+{
+	if (tile_obj == tv->tile_act)
+		return true;
+	if (tv->tile_act == NULL)
+		return false;
+
+	int32_t w = lv_obj_get_content_width((lv_obj_t *)tv);
+	int32_t h = lv_obj_get_content_height((lv_obj_t *)tv);
+	lv_point_t a, p;
+	tile_logical_pos(tv, tv->tile_act, &a);
+	tile_logical_pos(tv, tile_obj, &p);
+
+	int32_t dx = LV_ABS(p.x - a.x);
+	int32_t dy = LV_ABS(p.y - a.y);
+	return (dx == w && dy == 0) || (dx == 0 && dy == h);
+}
+
+static void tile_evict(watch_tileview_t * tv, watch_tileview_tile_t * tile)
+{
+	lv_obj_t *tile_obj = (lv_obj_t *)tile;
+
+	watch_tileview_snap_drop(tv, tile);
+	if (tile->free_cb)
+		tile->free_cb(tile_obj, tile->user_data);
+	lv_obj_clean(tile_obj);
+
+	tile->built = 0;
+	tv->mem_used -= LV_MIN(tile->cost, tv->mem_used);
+}
+
+/* 超预算时淘汰最久未见的非相邻、非钉住页；没有可淘汰的就超额建并告警 */
+static void tile_build(watch_tileview_t * tv, watch_tileview_tile_t * tile)
+{
+	while (tv->mem_used + tile->cost > WATCH_TILEVIEW_MEM_BUDGET) {
+		watch_tileview_tile_t *lru = NULL;
+
+		for (uint32_t i = 0; i < lv_obj_get_child_count((lv_obj_t *)tv); i++) {
+			watch_tileview_tile_t *t = (watch_tileview_tile_t *)lv_obj_get_child((lv_obj_t *)tv, i);
+			if (!t->build_cb || !t->built || t->pinned || tile_is_near(tv, (lv_obj_t *)t))
+				continue;
+			if (lru == NULL || (int32_t)(t->last_near - lru->last_near) < 0)
+				lru = t;
+		}
+		if (lru == NULL) {
+			LV_LOG_WARN("tile budget exceeded: %u + %u > %u", (unsigned)tv->mem_used,
+						(unsigned)tile->cost, (unsigned)WATCH_TILEVIEW_MEM_BUDGET);
+			break;
+		}
+		tile_evict(tv, lru);
+	}
+
+	tile->build_cb((lv_obj_t *)tile, tile->user_data);
+	tile->built = 1;
+	tv->mem_used += tile->cost;
+}
+
+/*
+ * 活动页变化后调用：
+ *  - 活动页立即建；相邻页 prefetch 时才建，否则排一次短延时预建
+ *  - 离开足够久的页释放，并把定时器排到下一个到期点；无事可做时暂停，不空转唤醒
+ */
+static void watch_tileview_update_residency(lv_obj_t * obj, bool prefetch)
+{
+	watch_tileview_t *tv = (watch_tileview_t *)obj;
+	uint32_t now = lv_tick_get();
+	uint32_t next = UINT32_MAX;
+
+	for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++) {
+		lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
+		watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tile_obj;
+		if (!tile->build_cb)
+			continue;
+
+		if (tile_is_near(tv, tile_obj)) {
+			tile->last_near = now;
+			if (!tile->built) {
+				if (prefetch || tile_obj == tv->tile_act)
+					tile_build(tv, tile);
+				else
+					next = LV_MIN(next, WATCH_TILEVIEW_PREFETCH_MS);
+			}
+		}
+		else if (tile->built && !tile->pinned) {
+			uint32_t away = lv_tick_diff(now, tile->last_near);
+			if (away >= WATCH_TILEVIEW_EVICT_MS)
+				tile_evict(tv, tile);
+			else
+				next = LV_MIN(next, WATCH_TILEVIEW_EVICT_MS - away);
+		}
+	}
+
+	if (next == UINT32_MAX) {
+		lv_timer_pause(tv->residency_timer);
+	}
+	else {
+		lv_timer_set_period(tv->residency_timer, next);
+		lv_timer_reset(tv->residency_timer);
+		lv_timer_resume(tv->residency_timer);
+	}
+}
+
+static void watch_tileview_residency_timer_cb(lv_timer_t * t)
+{
+	lv_obj_t *obj = lv_timer_get_user_data(t);
+
+	lv_timer_pause(t);
+	/* 滑动中不动页面内容，等 SCROLL_END 再整理 */
+	if (lv_obj_is_scrolling(obj))
+		return;
+	watch_tileview_update_residency(obj, true);
+}
+
+static void watch_tileview_build_visible(lv_obj_t * obj)
+{
+	watch_tileview_t *tv = (watch_tileview_t *)obj;
+
+	for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++) {
+		lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
+		watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tile_obj;
+		if (!tile->build_cb || tile->built)
+			continue;
+		if (lv_area_is_on(&tile_obj->coords, &obj->coords)) {
+			tile->last_near = lv_tick_get();
+			tile_build(tv, tile);
+		}
+	}
+}
+
+/*=====================
+ * Swipe snapshots
+ *====================*/
+
+/*
+ * 整页 RGB565 快照（240x280 约 131KB）放不进 LVGL 堆，所以只拍各顶层子控件所在的
+ * 矩形（连同下面的页背景，结果不透明）；页背景本身照常画，本来就只是一次填充。
+ * 顶层子控件多于 WATCH_TILEVIEW_SNAP_RECTS 个时合并成一个包围框；实时控件（SNAP_FLAG_LIVE）不拍。
+ * 返回矩形个数，out 为相对页左上角的坐标。
+ */
+static uint32_t snap_collect(lv_obj_t * tile_obj, lv_area_t out[])
+{
+	uint32_t n = 0;
+	bool merged = false;
+	lv_area_t bbox;
+
+	for (uint32_t i = 0; i < lv_obj_get_child_count(tile_obj); i++) {
+		lv_obj_t *child = lv_obj_get_child(tile_obj, i);
+		lv_area_t a;
+
+		if (lv_obj_has_flag_any(child, LV_OBJ_FLAG_HIDDEN | SNAP_FLAG_LIVE))
+			continue;
+		lv_obj_get_coords(child, &a);
+		int32_t ext = lv_obj_get_ext_draw_size(child);
+		lv_area_increase(&a, ext, ext);
+		if (!lv_area_intersect(&a, &a, &tile_obj->coords))
+			continue;
+
+		if (n == 0 && !merged)
+			bbox = a;
+		else
+			lv_area_join(&bbox, &bbox, &a);
+
+		if (n < WATCH_TILEVIEW_SNAP_RECTS && !merged)
+			out[n++] = a;
+		else
+			merged = true;
+	}
+
+	if (merged) {
+		out[0] = bbox;
+		n = 1;
+	}
+	for (uint32_t i = 0; i < n; i++)
+		lv_area_move(&out[i], -tile_obj->coords.x1, -tile_obj->coords.y1);
+	return n;
+}
+
+/* 把页在 abs（屏幕坐标）范围内的样子画进一块新的 RGB565 缓冲，做法同 lv_snapshot，只是裁到 abs */
+static lv_draw_buf_t * snap_render(lv_obj_t * tile_obj, const lv_area_t * abs)
+{
+	lv_draw_buf_t *buf = lv_draw_buf_create(lv_area_get_width(abs), lv_area_get_height(abs),
+											LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO);
+	if (buf == NULL)
+		return NULL;
+
+	lv_layer_t layer;
+	lv_memzero(&layer, sizeof(layer));
+	layer.draw_buf = buf;
+	layer.color_format = LV_COLOR_FORMAT_RGB565;
+	layer.buf_area = *abs;
+	layer._clip_area = *abs;
+#if LV_VERSION_CHECK(9, 3, 0)
+	layer.phy_clip_area = *abs;
+#endif
+
+	lv_obj_redraw(&layer, tile_obj);
+
+	/* 与 lv_canvas_finish_layer() 相同：把这一层的绘制任务跑完 */
+	lv_display_t *disp = lv_obj_get_display(tile_obj);
+	while (layer.draw_task_head) {
+		lv_draw_dispatch_wait_for_request();
+		if (!lv_draw_dispatch_layer(disp, &layer)) {
+			lv_draw_wait_for_finish();
+			lv_draw_dispatch_request();
+		}
+	}
+	return buf;
+}
+
+static void watch_tileview_snap_drop(watch_tileview_t * tv, watch_tileview_tile_t * tile)
+{
+	for (uint32_t i = 0; i < tile->snap_cnt; i++)
+		lv_draw_buf_destroy(tile->snap[i].buf);
+	tile->snap_cnt = 0;
+	tile->snap_valid = 0;
+	tile->snap_stale = 0;
+	tv->snap_used -= LV_MIN(tile->snap_bytes, tv->snap_used);
+	tile->snap_bytes = 0;
+}
+
+/* 把页上带 which 标志的可见顶层子控件临时隐藏（which=0：除实时控件外的全部），并打上 SNAP_FLAG_HIDDEN */
+static void snap_hide_children(lv_obj_t * tile_obj, lv_obj_flag_t which)
+{
+	for (uint32_t j = 0; j < lv_obj_get_child_count(tile_obj); j++) {
+		lv_obj_t *child = lv_obj_get_child(tile_obj, j);
+		if (lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN))
+			continue;
+		if (which ? !lv_obj_has_flag(child, which) : lv_obj_has_flag(child, SNAP_FLAG_LIVE))
+			continue;
+		lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN | SNAP_FLAG_HIDDEN);
+	}
+}
+
+static void snap_show_children(lv_obj_t * tile_obj)
+{
+	for (uint32_t j = 0; j < lv_obj_get_child_count(tile_obj); j++) {
+		lv_obj_t *child = lv_obj_get_child(tile_obj, j);
+		if (lv_obj_has_flag(child, SNAP_FLAG_HIDDEN))
+			lv_obj_remove_flag(child, LV_OBJ_FLAG_HIDDEN | SNAP_FLAG_HIDDEN);
+	}
+}
+
+/* 超预算时先丢最久没用过的其他页的快照；还放不下就放弃，这一页照常实时绘制 */
+static bool snap_take(watch_tileview_t * tv, watch_tileview_tile_t * tile)
+{
+	lv_obj_t *tile_obj = (lv_obj_t *)tile;
+	lv_area_t rel[WATCH_TILEVIEW_SNAP_RECTS];
+	uint32_t n = snap_collect(tile_obj, rel);
+	uint32_t need = 0;
+
+	for (uint32_t i = 0; i < n; i++)
+		need += (uint32_t)lv_area_get_size(&rel[i]) * 2U;
+	if (need > WATCH_TILEVIEW_SNAP_BUDGET)
+		return false;
+
+	while (tv->snap_used + need > WATCH_TILEVIEW_SNAP_BUDGET) {
+		watch_tileview_tile_t *lru = NULL;
+
+		for (uint32_t i = 0; i < lv_obj_get_child_count((lv_obj_t *)tv); i++) {
+			watch_tileview_tile_t *t = (watch_tileview_tile_t *)lv_obj_get_child((lv_obj_t *)tv, i);
+			if (t == tile || !t->snap_valid || t->snap_shown)
+				continue;
+			if (lru == NULL || (int32_t)(t->snap_tick - lru->snap_tick) < 0)
+				lru = t;
+		}
+		if (lru == NULL)
+			return false;
+		watch_tileview_snap_drop(tv, lru);
+	}
+
+	/* 实时控件压在快照矩形上时不能拍进去：滑动中它会画在快照上面，旧像素会从缝里露出来 */
+	snap_hide_children(tile_obj, SNAP_FLAG_LIVE);
+
+	bool ok = true;
+	for (uint32_t i = 0; i < n; i++) {
+		lv_area_t abs = rel[i];
+		lv_area_move(&abs, tile_obj->coords.x1, tile_obj->coords.y1);
+
+		lv_draw_buf_t *buf = snap_render(tile_obj, &abs);
+		if (buf == NULL) {
+			ok = false;
+			break;
+		}
+		tile->snap[i].area = rel[i];
+		tile->snap[i].buf = buf;
+		tile->snap_cnt = i + 1;
+	}
+
+	snap_show_children(tile_obj);
+	if (!ok) {
+		watch_tileview_snap_drop(tv, tile);
+		return false;
+	}
+
+	tile->snap_bytes = need;
+	tile->snap_valid = 1;
+	tv->snap_used += need;
+	return true;
+}
+
+/*
+ * 拖动开始：活动页和相邻页（这次滑动可能露出来的）换成快照——有效缓存直接用，
+ * 没有或已作废就现拍一次。真实子控件临时隐藏（SNAP_FLAG_HIDDEN 标记是我们隐藏的），
+ * 滑动中每帧只画页背景 + 几张图。
+ */
+static void watch_tileview_snap_begin(lv_obj_t * obj)
+{
+	watch_tileview_t *tv = (watch_tileview_t *)obj;
+	uint32_t now = lv_tick_get();
+
+	tv->snap_active = 1;
+
+	for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++) {
+		lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
+		watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tile_obj;
+
+		if (!tile->snap_en || !tile->built || tile->snap_shown || !tile_is_near(tv, tile_obj))
+			continue;
+		if (!tile->snap_valid && !snap_take(tv, tile))
+			continue;
+
+		snap_hide_children(tile_obj, 0);      /* 实时控件留着照常画 */
+		tile->snap_shown = 1;
+		tile->snap_tick = now;
+	}
+}
+
+/* 滑动停稳：恢复真实控件，快照留作下次滑动用，直到内容变化 */
+static void watch_tileview_snap_end(lv_obj_t * obj)
+{
+	watch_tileview_t *tv = (watch_tileview_t *)obj;
+
+	if (!tv->snap_active)
+		return;
+
+	for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++) {
+		lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
+		watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tile_obj;
+
+		if (!tile->snap_shown)
+			continue;
+		snap_show_children(tile_obj);
+		tile->snap_shown = 0;
+		/* 隐藏期间的变化不产生显示器失效，靠 invalidate_snapshot 记下的标志补上 */
+		if (tile->snap_stale) {
+			tile->snap_stale = 0;
+			watch_tileview_snap_drop(tv, tile);
+		}
+	}
+
+	/* 上面取消隐藏引起的失效不算内容变化，所以最后才清标志 */
+	tv->snap_active = 0;
+}
+
+/* 失效区完全落在某个实时控件里（如每秒走的时钟）：快照里本来就没有它 */
+static bool snap_area_is_live(lv_obj_t * tile_obj, const lv_area_t * area)
+{
+	for (uint32_t j = 0; j < lv_obj_get_child_count(tile_obj); j++) {
+		lv_obj_t *child = lv_obj_get_child(tile_obj, j);
+		if (!lv_obj_has_flag(child, SNAP_FLAG_LIVE))
+			continue;
+
+		lv_area_t a;
+		lv_obj_get_coords(child, &a);
+		int32_t ext = lv_obj_get_ext_draw_size(child);
+		lv_area_increase(&a, ext, ext);
+		if (lv_area_is_in(area, &a, 0))
+			return true;
+	}
+	return false;
+}
+
+/* 停稳时屏上有重绘：落在哪个已缓存的页上，哪页的快照就作废 */
+static void watch_tileview_snap_disp_event_cb(lv_event_t * e)
+{
+	lv_obj_t *obj = lv_event_get_user_data(e);
+	watch_tileview_t *tv = (watch_tileview_t *)obj;
+	const lv_area_t *area = lv_event_get_param(e);
+
+	if (tv->snap_active || area == NULL || lv_obj_get_screen(obj) != lv_screen_active())
+		return;
+
+	for (uint32_t i = 0; i < lv_obj_get_child_count(obj); i++) {
+		lv_obj_t *tile_obj = lv_obj_get_child(obj, i);
+		watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tile_obj;
+
+		if (tile->snap_valid && lv_area_is_on(area, &tile_obj->coords) &&
+			!snap_area_is_live(tile_obj, area))
+			watch_tileview_snap_drop(tv, tile);
+	}
+}
+
+static void watch_tileview_tile_event_cb(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+	LV_UNUSED(class_p);
+
+	lv_result_t res = lv_obj_event_base(&watch_tileview_tile_class, e);
+	if (res != LV_RESULT_OK) return;
+
+	if (lv_event_get_code(e) != LV_EVENT_DRAW_MAIN_END)
+		return;
+
+	lv_obj_t *tile_obj = lv_event_get_current_target(e);
+	watch_tileview_tile_t *tile = (watch_tileview_tile_t *)tile_obj;
+	if (!tile->snap_shown)
+		return;
+
+	/* 页背景已在 DRAW_MAIN 画好，子控件被隐藏，这里把快照贴回原位 */
+	lv_layer_t *layer = lv_event_get_layer(e);
+	for (uint32_t i = 0; i < tile->snap_cnt; i++) {
+		lv_draw_image_dsc_t dsc;
+		lv_draw_image_dsc_init(&dsc);
+		dsc.src = tile->snap[i].buf;
+
+		lv_area_t a = tile->snap[i].area;
+		lv_area_move(&a, tile_obj->coords.x1, tile_obj->coords.y1);
+		lv_draw_image(layer, &dsc, &a);
 	}
 }
@@ -26,10 +26,57 @@ extern "C" {
  *      DEFINES
  *********************/
 
+/* 环形主轴每隔这么多列整体平移一次（只有这一次是 O(页数)），坐标始终非负且有界 */
+#ifndef WATCH_TILEVIEW_RING_RENORM
+#define WATCH_TILEVIEW_RING_RENORM  1024
+#endif
+/* 懒加载页：离开可视/相邻位置超过该时间后释放内容 */
+#ifndef WATCH_TILEVIEW_EVICT_MS
+#define WATCH_TILEVIEW_EVICT_MS     30000
+#endif
+/* 活动页切换后，相邻页延后这么久再预建，先让当前页出帧 */
+#ifndef WATCH_TILEVIEW_PREFETCH_MS
+#define WATCH_TILEVIEW_PREFETCH_MS  50
+#endif
+/* 懒加载页内容可占用的 LVGL 内存上限（按各页登记的估算值累计），超出时先淘汰最久未见的页 */
+#ifndef WATCH_TILEVIEW_MEM_BUDGET
+#ifdef CONFIG_LV_Z_MEM_POOL_SIZE
+#define WATCH_TILEVIEW_MEM_BUDGET   (CONFIG_LV_Z_MEM_POOL_SIZE / 2)
+#else
+#define WATCH_TILEVIEW_MEM_BUDGET   (32 * 1024)
+#endif
+#endif
+
+/* 滑动快照可占用的 LVGL 内存上限（RGB565，按实际像素累计）；定义为 0 关闭快照 */
+#ifndef WATCH_TILEVIEW_SNAP_BUDGET
+#ifdef CONFIG_LV_Z_MEM_POOL_SIZE
+#define WATCH_TILEVIEW_SNAP_BUDGET  (CONFIG_LV_Z_MEM_POOL_SIZE / 4)
+#else
+#define WATCH_TILEVIEW_SNAP_BUDGET  (16 * 1024)
+#endif
+#endif
+/* 每页最多几块快照矩形，顶层子控件更多时合并成一个包围框 */
+#ifndef WATCH_TILEVIEW_SNAP_RECTS
+#define WATCH_TILEVIEW_SNAP_RECTS   4
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * Tile content factory: create the tile's children.
+ * Called the first time the tile becomes active or adjacent to the active tile,
+ * and again after each eviction.
+ */
+typedef void (*watch_tileview_build_cb_t)(lv_obj_t * tile, void * user_data);
+
+/**
+ * Called right before the tile's children are deleted on eviction,
+ * so owners can drop pointers to them. May be NULL.
+ */
+typedef void (*watch_tileview_free_cb_t)(lv_obj_t * tile, void * user_data);
+
 
 
 
@@ -86,6 +133,60 @@ lv_obj_t * watch_tileview_get_tile_act(lv_obj_t * obj);
 
 
 void watch_tileview_set_start_tile(lv_obj_t* obj, lv_obj_t* tile_obj);
+
+/**
+ * Let a tile build its content lazily instead of up front.
+ * The content is created when the tile nears the viewport (active or adjacent)
+ * and freed after it has been away for WATCH_TILEVIEW_EVICT_MS, or earlier
+ * when WATCH_TILEVIEW_MEM_BUDGET would be exceeded.
+ * Tiles without a factory keep their content forever.
+ * @param obj pointer to a tileview object
+ * @param tile_obj tile returned by watch_tileview_add_tiles(), must be empty
+ * @param build_cb creates the content
+ * @param free_cb called before the content is deleted, may be NULL
+ * @param user_data passed to both callbacks
+ * @param est_bytes rough LVGL heap usage of the content, charged against the budget
+ */
+void watch_tileview_set_tile_factory(lv_obj_t * obj, lv_obj_t * tile_obj,
+									 watch_tileview_build_cb_t build_cb,
+									 watch_tileview_free_cb_t free_cb,
+									 void * user_data, uint32_t est_bytes);
+
+/**
+ * Keep a lazy tile's content once built (e.g. the home face)
+ * @param tile_obj tile with a factory
+ * @param pinned true: never evict
+ */
+void watch_tileview_pin_tile(lv_obj_t * tile_obj, bool pinned);
+
+/**
+ * Draw a tile from cached RGB565 snapshots while it is being swiped.
+ * When a drag begins, the active tile and its neighbours get their top-level
+ * children snapshotted (or reuse a still valid cache) and hidden; the live
+ * widgets come back once the scroll settles. Only suits tiles whose content
+ * does not animate during a swipe.
+ * @param tile_obj tile returned by watch_tileview_add_tiles()
+ * @param en true: enable, false: disable and free the cache
+ */
+void watch_tileview_set_tile_snapshot(lv_obj_t * tile_obj, bool en);
+
+/**
+ * Drop the snapshot of the tile containing obj.
+ * Redraws of the visible tiles are noticed automatically; call this when
+ * content changes while its tile is off-screen.
+ * @param obj a tile or any object inside one
+ */
+void watch_tileview_invalidate_snapshot(lv_obj_t * obj);
+
+/**
+ * Keep a top-level child of a snapshotted tile out of the cache and draw it
+ * live during swipes. Use it for content that changes every second (a clock):
+ * its redraws then no longer invalidate the tile's snapshot, so the cache
+ * survives until the next swipe instead of being re-rendered on its first frame.
+ * @param obj a direct child of a tile
+ * @param live true: draw live, false: include in the snapshot again
+ */
+void watch_tileview_set_live(lv_obj_t * obj, bool live);
 /*=====================
  * Other functions
  *====================*/
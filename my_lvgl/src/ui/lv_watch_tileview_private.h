@@ -21,12 +21,47 @@ extern "C" {
         uint8_t main_rotated : 1;
         uint8_t cross_overlapped : 1;
 
+        /* 环形主轴：最前一列的列号及该列上的主轴页下标 */
+        int32_t ring_origin;
+        uint8_t ring_head;
+
         lv_style_t style;
+
+        /* 懒加载：已建页登记的内存估算合计，预建/淘汰共用一个单发定时器 */
+        uint32_t mem_used;
+        lv_timer_t* residency_timer;
+
+        /* 滑动快照：已缓存的字节数；snap_active 期间显示器的失效不算内容变化 */
+        uint32_t snap_used;
+        lv_display_t* snap_disp;
+        uint8_t snap_active : 1;
 } watch_tileview_t;
 
+typedef struct {
+    lv_area_t area;                       /* 相对页左上角 */
+    lv_draw_buf_t* buf;                   /* RGB565，不透明 */
+} watch_tileview_snap_rect_t;
+
 typedef struct {
     lv_obj_t obj;
     lv_dir_t dir;
+
+    watch_tileview_build_cb_t build_cb;   /* NULL = 内容常驻 */
+    watch_tileview_free_cb_t free_cb;
+    void* user_data;
+    uint32_t cost;
+    uint32_t last_near;                   /* lv_tick：最后一次处于活动/相邻位置 */
+    uint8_t built : 1;
+    uint8_t pinned : 1;
+
+    watch_tileview_snap_rect_t* snap;     /* WATCH_TILEVIEW_SNAP_RECTS 项，启用时分配 */
+    uint32_t snap_bytes;
+    uint32_t snap_tick;                   /* lv_tick：最后一次拿快照代替绘制 */
+    uint8_t snap_cnt;
+    uint8_t snap_en : 1;
+    uint8_t snap_valid : 1;
+    uint8_t snap_shown : 1;
+    uint8_t snap_stale : 1;                /* 滑动中内容变了：停稳时丢掉快照 */
 } watch_tileview_tile_t;
 
 #endif
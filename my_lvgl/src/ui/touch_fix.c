@@ -2,6 +2,9 @@
 #include <zephyr/input/input.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(touch_fix, LOG_LEVEL_INF);
+
+#include "app/backlight_ctrl.h"
+#include "ui_app.h"
 /* 通过 alias(input) 锁定你的触摸设备 */
 static const struct device *const touch_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_keyboard_scan));
 
@@ -26,6 +29,11 @@ static void touch_fix_cb(struct input_event *evt, void *user_data)
         (evt->type == INPUT_EV_ABS && (evt->code == INPUT_ABS_X || evt->code == INPUT_ABS_Y))) {
         blctl_wake();
     }
+    /* 一组坐标/按键上报完毕：叫醒 UI 循环读触摸（indev 是事件模式，不再定时轮询）。
+     * 输入线程优先级高于 UI 线程，UI 要等本批回调都跑完（LVGL 已入队）才会开始读 */
+    if (evt->sync) {
+        ui_app_kick_input();
+    }
     if (evt->type == INPUT_EV_ABS && evt->code == INPUT_ABS_Y) {
         int32_t v = evt->value - TOUCH_Y_OFFSET;
         if (v < 0) v = 0;
@@ -0,0 +1,137 @@
+#include "ui_aod.h"
+#include "ui_digit_atlas.h"
+#include "ui_disp_pipe.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/drivers/mipi_dbi.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/posix/time.h>
+#include <zephyr/logging/log.h>
+#include <lvgl.h>
+LOG_MODULE_REGISTER(ui_aod, LOG_LEVEL_INF);
+
+#define AOD_PANEL          DT_CHOSEN(zephyr_display)
+#define AOD_XRES           DT_PROP(AOD_PANEL, width)
+
+#define ST7789_CMD_IDMOFF  0x38
+#define ST7789_CMD_IDMON   0x39
+
+#define AOD_TEXT_LEN       5            /* "HH:MM" */
+#define AOD_STRIP_PX       (AOD_XRES * UI_AOD_STRIP_LINES)
+
+static const struct device *const s_disp = DEVICE_DT_GET(AOD_PANEL);
+static const struct device *const s_dbi  = DEVICE_DT_GET(DT_PARENT(AOD_PANEL));
+static const struct mipi_dbi_config s_dbi_cfg =
+    MIPI_DBI_CONFIG_DT(AOD_PANEL, SPI_OP_MODE_MASTER | SPI_WORD_SET(8), 0);
+
+/* SPIM EasyDMA 只能读 RAM：字形在 flash 里，按条带拷到这里再写 */
+static uint16_t s_strip[AOD_STRIP_PX] __aligned(4);
+
+static char     s_shown[AOD_TEXT_LEN + 1];   /* 屏上现在的字；全 0 = 全部要画 */
+static uint16_t s_x0, s_y0;                  /* 时钟左上角 */
+
+static void idle_mode(bool on)
+{
+    uint8_t cmd = on ? ST7789_CMD_IDMON : ST7789_CMD_IDMOFF;
+    int err = mipi_dbi_command_write(s_dbi, &s_dbi_cfg, cmd, NULL, 0);
+    if (err) {
+        LOG_WRN("idle mode %s failed: %d", on ? "on" : "off", err);
+    }
+}
+
+static void write_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    const struct display_buffer_descriptor desc = {
+        .buf_size = (uint32_t)w * h * 2U,
+        .width    = w,
+        .height   = h,
+        .pitch    = w,
+    };
+    (void)display_write(s_disp, x, y, &desc, s_strip);
+}
+
+static void clear_screen(uint16_t xres, uint16_t yres)
+{
+    memset(s_strip, 0, sizeof(s_strip));            /* 黑色两种字节序都是 0 */
+    uint16_t lines = (uint16_t)(AOD_STRIP_PX / xres);
+    for (uint16_t y = 0; y < yres; y += lines) {
+        write_rect(0, y, xres, MIN(lines, yres - y));
+    }
+}
+
+/* 一个字形按条带拷贝 + 写出；图集已是面板字节序，不再交换 */
+static void draw_glyph(const lv_image_dsc_t *img, uint16_t x, uint16_t y)
+{
+    uint16_t w = img->header.w, h = img->header.h;
+    uint16_t lines = (uint16_t)(AOD_STRIP_PX / w);
+
+    for (uint16_t r = 0; r < h; r += lines) {
+        uint16_t n = MIN(lines, h - r);
+        memcpy(s_strip, img->data + (size_t)r * img->header.stride, (size_t)n * img->header.stride);
+        write_rect(x, y + r, w, n);
+    }
+}
+
+static uint16_t glyph_w(char c)
+{
+    const lv_image_dsc_t *img = ui_digit_atlas_find(&ui_atlas_aod, c);
+    return img ? img->header.w : ui_atlas_aod.digit_w;
+}
+
+void ui_aod_enter(void)
+{
+    /* LVGL 已停画，但最后一帧可能还在 flush 线程里：先等它写完，免得盖住时钟 */
+    ui_disp_pipe_wait_idle();
+    idle_mode(true);
+
+    struct display_capabilities caps;
+    display_get_capabilities(s_disp, &caps);
+
+    /* 数字定宽，只有冒号不同：总宽固定，位置算一次 */
+    uint16_t tw = 4U * ui_atlas_aod.digit_w + glyph_w(':');
+    s_x0 = (uint16_t)((caps.x_resolution - tw) / 2U);
+    s_y0 = (uint16_t)((caps.y_resolution - ui_atlas_aod.h) / 2 + UI_AOD_Y_OFS);
+
+    clear_screen(caps.x_resolution, caps.y_resolution);
+    memset(s_shown, 0, sizeof(s_shown));
+    LOG_INF("AOD on");
+}
+
+uint32_t ui_aod_update(void)
+{
+    char text[AOD_TEXT_LEN + 1] = "--:--";
+    uint32_t next_ms = 60000U;
+
+    struct timespec ts;
+    struct tm tm_local;
+    if (clock_gettime(CLOCK_REALTIME, &ts) == 0 && localtime_r(&ts.tv_sec, &tm_local)) {
+        snprintf(text, sizeof(text), "%02d:%02d", tm_local.tm_hour, tm_local.tm_min);
+        /* 睡到下一个整分，多给 1ms 保证醒来时分钟已经变了 */
+        next_ms = (uint32_t)(59 - tm_local.tm_sec) * 1000U +
+                  (uint32_t)(1000 - ts.tv_nsec / 1000000) + 1U;
+    }
+
+    uint16_t x = s_x0;
+    for (int i = 0; i < AOD_TEXT_LEN; i++) {
+        const lv_image_dsc_t *img = ui_digit_atlas_find(&ui_atlas_aod, text[i]);
+        if (img && s_shown[i] != text[i]) {
+            draw_glyph(img, x, s_y0);
+        }
+        x += glyph_w(text[i]);
+    }
+    memcpy(s_shown, text, sizeof(s_shown));
+    return next_ms;
+}
+
+void ui_aod_exit(void)
+{
+    idle_mode(false);
+    /* 屏上是 AOD 的画面，LVGL 的脏区记录不知道：整屏重画 */
+    lv_obj_invalidate(lv_screen_active());
+    LOG_INF("AOD off");
+}
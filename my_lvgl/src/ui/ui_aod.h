@@ -0,0 +1,32 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 常亮（AOD）时钟：backlight_ctrl 进入 BLCTL_ST_AOD 时由暂停中的 UI 线程驱动
+ *  - 面板切到 ST7789 idle 模式（IDMON，8 色、帧率降低），背光只留几个百分点
+ *  - 不跑 LVGL：直接把 ui_atlas_aod 的字形 display_write 到屏上，只画 HH:MM
+ *  - 每分钟醒一次，只重写变化的字符格
+ * 三个函数都只在 UI 线程、LVGL 停画期间调用 */
+
+#ifndef UI_AOD_STRIP_LINES
+#define UI_AOD_STRIP_LINES  4       /* 清屏/拷字形用的 RAM 条带：整行宽 × 这么多行 */
+#endif
+#ifndef UI_AOD_Y_OFS
+#define UI_AOD_Y_OFS        0       /* 时钟相对屏幕中心的纵向偏移（像素） */
+#endif
+
+/* 等 flush 流水线排空，进 idle 模式并清成黑底；之后第一次 update 画全部字符 */
+void     ui_aod_enter(void);
+
+/* 按当前时间重画变化的字符格；返回距下一个整分的毫秒数，供调用方睡眠 */
+uint32_t ui_aod_update(void);
+
+/* 退出 idle 模式并让 LVGL 整屏重画（恢复渲染后的第一帧） */
+void     ui_aod_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -8,11 +8,19 @@
 #include <zephyr/kernel.h>
 #include <zephyr/kernel/thread.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
 #include <hal/nrf_gpio.h>
 
 #include "ui_time_display.h"
 #include "ui_main_view.h"
+#include "ui_disp_stats.h"
+#include "ui_disp_pipe.h"
+#include "ui_mailbox.h"
+#include "ui_aod.h"
 #include "ui_app.h"
+#include "app/backlight_ctrl.h"
+#include "app/key_cmd.h"
 
 LOG_MODULE_REGISTER(ui_app, LOG_LEVEL_INF);
 
@@ -21,11 +29,196 @@ LOG_MODULE_REGISTER(ui_app, LOG_LEVEL_INF);
 #define UI_THREAD_STACK_SIZE 1024 * 8
 #define UI_THREAD_PRIORITY 2
 
+/* UI 循环睡眠上限：lv_timer_handler() 没有到期定时器时也最多睡这么久 */
+#ifndef UI_LOOP_MAX_MS
+#define UI_LOOP_MAX_MS     500
+#endif
+
 const struct device *display_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
 const struct device *input_dev   = DEVICE_DT_GET(DT_CHOSEN(zephyr_keyboard_scan));
 
 
-/* UI 侧实现回调（示例） */
+/* ==== 显示电源联动：屏幕不可见（SLEEP/OFF）或常亮（AOD）时 LVGL 停下 ====
+ * 不跑 lv_timer_handler 就意味着：不渲染、1s 时钟定时器不走、触摸 indev 不轮询；
+ * 唤醒仍由 touch_fix 的 INPUT_CALLBACK 在输入线程里触发，与 LVGL 无关。
+ * AOD 期间线程每分钟醒一次，用 ui_aod 直接写屏画时钟。
+ */
+static atomic_t s_paused = ATOMIC_INIT(0);
+static atomic_t s_aod    = ATOMIC_INIT(0);
+static K_SEM_DEFINE(s_resume_sem, 0, 1);
+
+/* 循环唤醒：邮箱投递 / 输入 / 暂停请求都 give 这一个信号量 */
+static K_SEM_DEFINE(s_kick_sem, 0, 1);
+static atomic_t s_input_pending = ATOMIC_INIT(0);
+
+void ui_app_kick(void)
+{
+    k_sem_give(&s_kick_sem);
+}
+
+void ui_app_kick_aod(void)
+{
+    /* AOD 期间线程停在 s_resume_sem 上，只按整分醒；这里让它马上重画一次 */
+    if (atomic_get(&s_aod)) {
+        k_sem_give(&s_resume_sem);
+    }
+}
+
+void ui_app_kick_input(void)
+{
+    atomic_set(&s_input_pending, 1);
+    k_sem_give(&s_kick_sem);
+}
+
+static void ui_blctl_cb(const struct zbus_channel *chan)
+{
+    const struct blctl_state_msg *m = zbus_chan_const_msg(chan);
+    bool aod   = (m->state == BLCTL_ST_AOD);
+    bool pause = aod || m->state == BLCTL_ST_SLEEP || m->state == BLCTL_ST_OFF;
+
+    atomic_set(&s_aod, aod ? 1 : 0);
+    atomic_set(&s_paused, pause ? 1 : 0);
+    /* 暂停中的线程也要看：恢复，或 AOD ↔ SLEEP 之间切换 */
+    k_sem_give(&s_resume_sem);
+    if (pause) {
+        ui_app_kick();                  /* 让循环马上进入暂停，而不是睡到下一个定时器 */
+    }
+}
+ZBUS_LISTENER_DEFINE(ui_blctl_listener, ui_blctl_cb);
+ZBUS_CHAN_ADD_OBS(blctl_state_chan, ui_blctl_listener, 3);
+
+/* ==== 按键命令：回表盘在 LVGL 线程里做 ==== */
+static void ui_key_cb(const struct zbus_channel *chan)
+{
+    const struct key_cmd_msg *m = zbus_chan_const_msg(chan);
+
+    if (m->cmd == KEY_CMD_HOME) {
+        ui_mailbox_post(UI_MB_GO_HOME, 0);
+    }
+}
+ZBUS_LISTENER_DEFINE(ui_key_listener, ui_key_cb);
+ZBUS_CHAN_ADD_OBS(key_cmd_chan, ui_key_listener, 3);
+
+static void ui_set_indev_enabled(bool en)
+{
+    for (lv_indev_t *i = lv_indev_get_next(NULL); i; i = lv_indev_get_next(i)) {
+        lv_indev_enable(i, en);
+    }
+}
+
+/* ==== indev 事件模式 ====
+ * 读定时器（LV_DEF_REFR_PERIOD ≈ 33ms）平时暂停，否则 lv_timer_handler() 永远
+ * 不会返回超过 33ms；touch_fix 叫醒时由本线程主动读。按住期间恢复定时器，
+ * 长按、保活照常靠持续读来检测，松开后再停。 */
+#ifndef UI_INDEV_MAX
+#define UI_INDEV_MAX        4
+#endif
+#ifndef UI_INDEV_READ_MAX
+#define UI_INDEV_READ_MAX   8       /* 一次叫醒最多连读几帧，输入源一直有数据时也不卡在这里 */
+#endif
+
+static struct {
+    lv_indev_t        *indev;
+    lv_indev_read_cb_t read_cb;     /* Zephyr 胶水层原来的读回调 */
+} s_indevs[UI_INDEV_MAX];
+static bool s_indev_more;           /* 最近一次读回调报告缓存里还有数据 */
+
+/* 包一层原读回调，只为拿到 continue_reading：事件模式下 lv_indev_read() 只读一帧 */
+static void ui_indev_read_cb(lv_indev_t *indev, lv_indev_data_t *data)
+{
+    for (size_t n = 0; n < ARRAY_SIZE(s_indevs) && s_indevs[n].indev; n++) {
+        if (s_indevs[n].indev == indev) {
+            s_indevs[n].read_cb(indev, data);
+            s_indev_more = data->continue_reading;
+            return;
+        }
+    }
+}
+
+static void ui_indev_use_event_mode(void)
+{
+    size_t n = 0;
+
+    for (lv_indev_t *i = lv_indev_get_next(NULL); i; i = lv_indev_get_next(i)) {
+        if (n == ARRAY_SIZE(s_indevs)) {
+            LOG_WRN("indev %p stays in timer mode (UI_INDEV_MAX=%d)", (void *)i, UI_INDEV_MAX);
+            continue;
+        }
+        s_indevs[n].indev = i;
+        s_indevs[n].read_cb = lv_indev_get_read_cb(i);
+        lv_indev_set_read_cb(i, ui_indev_read_cb);
+        lv_indev_set_mode(i, LV_INDEV_MODE_EVENT);
+        n++;
+    }
+}
+
+/* 按住才让读定时器跑；每次读完（叫醒或定时器）都要重新对一遍 */
+static void ui_indev_update_timers(void)
+{
+    for (size_t n = 0; n < ARRAY_SIZE(s_indevs) && s_indevs[n].indev; n++) {
+        lv_timer_t *t = lv_indev_get_read_timer(s_indevs[n].indev);
+
+        if (!t) {
+            continue;
+        }
+        if (lv_indev_get_state(s_indevs[n].indev) == LV_INDEV_STATE_PRESSED) {
+            lv_timer_resume(t);
+        } else {
+            lv_timer_pause(t);
+        }
+    }
+}
+
+/* 触摸叫醒后把每个 indev 的缓存读空：一次 sync 之前可能已排了好几帧 */
+static void ui_read_indevs(void)
+{
+    for (size_t n = 0; n < ARRAY_SIZE(s_indevs) && s_indevs[n].indev; n++) {
+        int reads = 0;
+
+        do {
+            s_indev_more = false;
+            lv_indev_read(s_indevs[n].indev);
+        } while (s_indev_more && ++reads < UI_INDEV_READ_MAX);
+    }
+    ui_indev_update_timers();
+}
+
+/* 返回本次暂停期间是否画过 AOD：是的话面板显存里不是 LVGL 的画面，
+ * 恢复后第一帧上屏才能通知 backlight_ctrl 渐亮 */
+static bool ui_pause_until_visible(void)
+{
+    LOG_INF("UI paused");
+    ui_time_display_pause(true);
+    ui_set_indev_enabled(false);
+
+    /* 以标志为准：信号量里可能残留之前的 give，醒来再确认一次 */
+    bool in_aod = false, shown_aod = false;
+    while (atomic_get(&s_paused)) {
+        k_timeout_t wait = K_FOREVER;
+
+        if (atomic_get(&s_aod)) {
+            if (!in_aod) {
+                ui_aod_enter();
+                in_aod = shown_aod = true;
+            }
+            wait = K_MSEC(ui_aod_update());     /* 睡到下一个整分 */
+        } else if (in_aod) {
+            ui_aod_exit();                      /* AOD → SLEEP：面板已 DISPOFF */
+            in_aod = false;
+        }
+        (void)k_sem_take(&s_resume_sem, wait);
+    }
+    if (in_aod) {
+        ui_aod_exit();
+    }
+
+    ui_set_indev_enabled(true);
+    lv_indev_reset(NULL, NULL);         /* 丢掉暂停前残留的按下状态 */
+    ui_indev_update_timers();           /* 暂停前若按着，读定时器先跑着等松开 */
+    ui_time_display_pause(false);       /* 立即刷新时钟，首帧就是正确时间 */
+    LOG_INF("UI resumed");
+    return shown_aod;
+}
 
 
 void ui_thread(void *arg1, void *arg2, void *arg3)
@@ -42,13 +235,49 @@ void ui_thread(void *arg1, void *arg2, void *arg3)
         LOG_WRN("Input device not ready (ok if none)");
     }
     display_blanking_off(display_dev);
+    ui_disp_stats_init(lv_display_get_default());
+    if (ui_disp_pipe_init(lv_display_get_default()) != 0) {
+        LOG_WRN("display pipe init failed, keeping synchronous flush");
+    }
+    ui_indev_use_event_mode();
 
     ui_show_main_with_watch_tileview();  // 这里面应当调用 ui_steps_display_init() 创建步数控件
     lv_timer_handler();                  // 做一次首帧渲染
+#ifdef UI_BENCH
+    extern void ui_digits_bench_run(void);
+    extern void ui_tileview_bench_run(void);
+    ui_digits_bench_run();
+    ui_tileview_bench_run();
+#endif
 
+    bool redraw_after_aod = false;
     while (1) {
-        k_sleep(K_MSEC(30));
-        lv_timer_handler();
+        if (atomic_get(&s_paused)) {
+            redraw_after_aod = ui_pause_until_visible();
+        }
+        if (atomic_clear(&s_input_pending)) {
+            /* 输入线程优先级比本线程高（prj.conf），touch_fix 叫醒时本线程并不会
+             * 抢占它：等轮到这里，同一批事件已全部交给 LVGL 的输入回调入队 */
+            ui_read_indevs();
+        }
+
+        /* 其他线程投来的更新：每个字段只取最新值处理一次，随后同一帧渲染 */
+        ui_mailbox_drain();
+
+        /* 睡到下一个 LVGL 定时器到期：动画/刷新/按住期间很短；静止时 indev 读定时器
+         * 已暂停，只剩时钟的 1s 定时器。期间的邮箱投递、触摸、暂停请求都会提前唤醒 */
+        uint32_t wait = lv_timer_handler();
+        ui_indev_update_timers();       /* 定时器读到松开就停 */
+        if (redraw_after_aod) {
+            /* 整屏重画已交给 flush 线程：等它写完再让背光亮起来 */
+            ui_disp_pipe_wait_idle();
+            blctl_ui_drawn();
+            redraw_after_aod = false;
+        }
+        if (wait == LV_NO_TIMER_READY || wait > UI_LOOP_MAX_MS) {
+            wait = UI_LOOP_MAX_MS;
+        }
+        (void)k_sem_take(&s_kick_sem, K_MSEC(wait));
     }
 }
 
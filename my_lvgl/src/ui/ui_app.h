@@ -5,6 +5,17 @@ extern "C" {
 
 void ui_app_init(void);
 
+/* UI 循环按 lv_timer_handler() 返回的下一次到期时间睡眠；以下两个接口让它提前醒来 */
+
+/* 任意线程：让 UI 线程马上醒来（ui_mailbox_post 已自带） */
+void ui_app_kick(void);
+
+/* 任意线程：常亮（AOD）时钟需要马上重画（如系统时间被设置）；不在 AOD 时无操作 */
+void ui_app_kick_aod(void);
+
+/* 输入线程：有新的触摸数据，UI 线程醒来后立即读 indev，不等 indev 读定时器 */
+void ui_app_kick_input(void);
+
 /* Optional hook: user activity like raise-wrist can be unified here */
 
 #ifdef __cplusplus
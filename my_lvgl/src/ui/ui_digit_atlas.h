@@ -0,0 +1,40 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 数字精灵图集：构建时由 scripts/gen_digit_atlas.py 从 Montserrat 字体栅格化，
+ * 前景/背景色已预先混合成不透明 RGB565，放在 flash 里直接当图片拷贝 */
+struct ui_digit_atlas {
+    const char           *glyphs;    /* 与 imgs 一一对应，'\0' 结尾 */
+    const lv_image_dsc_t *imgs;
+    uint8_t               n;
+    uint8_t               h;         /* 精灵高度 = 字体行高 */
+    uint8_t               digit_w;   /* 数字与空格的统一宽度 */
+    uint32_t              fg;        /* 生成时烘焙的颜色 0xRRGGBB */
+    uint32_t              bg;        /* 控件所在背景必须是这个颜色 */
+    bool                  swapped;   /* true = 面板字节序，只能直接 display_write */
+};
+
+/* 表盘（蓝色中心页）与步数（灰色左页），颜色见 ui/CMakeLists.txt */
+extern const struct ui_digit_atlas ui_atlas_clock;
+extern const struct ui_digit_atlas ui_atlas_steps;
+/* 常亮时钟：Montserrat 48 白字黑底，面板字节序（swapped），只给 ui_aod 直接写屏 */
+extern const struct ui_digit_atlas ui_atlas_aod;
+
+/* 查字形；图集里没有的字符返回 NULL（按空格处理） */
+static inline const lv_image_dsc_t *ui_digit_atlas_find(const struct ui_digit_atlas *a, char c)
+{
+    for (uint8_t i = 0; i < a->n; i++) {
+        if (a->glyphs[i] == c) return &a->imgs[i];
+    }
+    return NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,120 @@
+#include "ui_digits.h"
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+
+struct ui_digits {
+    const struct ui_digit_atlas *atlas;
+    char txt[UI_DIGITS_MAX + 1];
+};
+
+static int32_t char_w(const struct ui_digit_atlas *a, char c)
+{
+    const lv_image_dsc_t *img = ui_digit_atlas_find(a, c);
+    return img ? (int32_t)img->header.w : a->digit_w;
+}
+
+int32_t ui_digits_draw(lv_layer_t *layer, const struct ui_digit_atlas *atlas,
+                       const char *txt, int32_t x, int32_t y)
+{
+    lv_draw_image_dsc_t img_dsc;
+    lv_draw_image_dsc_init(&img_dsc);
+
+    for (const char *p = txt; *p; p++) {
+        const lv_image_dsc_t *img = ui_digit_atlas_find(atlas, *p);
+        int32_t w = img ? (int32_t)img->header.w : atlas->digit_w;
+        lv_area_t a = { x, y, x + w - 1, y + atlas->h - 1 };
+
+        if (img) {
+            img_dsc.src = img;
+            lv_draw_image(layer, &img_dsc, &a);
+        } else {
+            lv_draw_rect_dsc_t r;
+            lv_draw_rect_dsc_init(&r);
+            r.bg_color = lv_color_hex(atlas->bg);
+            lv_draw_rect(layer, &r, &a);
+        }
+        x += w;
+    }
+    return x;
+}
+
+static void digits_event_cb(lv_event_t *e)
+{
+    lv_obj_t *obj = lv_event_get_current_target_obj(e);
+    struct ui_digits *d = lv_obj_get_user_data(obj);
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_DRAW_MAIN:
+        (void)ui_digits_draw(lv_event_get_layer(e), d->atlas, d->txt,
+                             obj->coords.x1, obj->coords.y1);
+        break;
+    case LV_EVENT_DELETE:
+        lv_obj_set_user_data(obj, NULL);
+        lv_free(d);
+        break;
+    default:
+        break;
+    }
+}
+
+lv_obj_t *ui_digits_create(lv_obj_t *parent, const struct ui_digit_atlas *atlas)
+{
+    __ASSERT(!atlas->swapped, "swapped atlas cannot go through the LVGL draw buffer");
+
+    struct ui_digits *d = lv_malloc_zeroed(sizeof(*d));
+    if (!d) return NULL;
+    d->atlas = atlas;
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_size(obj, 0, atlas->h);
+    /* 不透明背景 = 图集背景色：LVGL 的遮挡检查据此从本控件开始画，不再先画下面的页面 */
+    lv_obj_set_style_bg_color(obj, lv_color_hex(atlas->bg), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_user_data(obj, d);
+    lv_obj_add_event_cb(obj, digits_event_cb, LV_EVENT_ALL, NULL);
+    return obj;
+}
+
+void ui_digits_set_text(lv_obj_t *obj, const char *txt)
+{
+    struct ui_digits *d = lv_obj_get_user_data(obj);
+    if (!d) return;
+
+    char buf[UI_DIGITS_MAX + 1];
+    strncpy(buf, txt, UI_DIGITS_MAX);
+    buf[UI_DIGITS_MAX] = '\0';
+    if (strcmp(buf, d->txt) == 0) return;
+
+    const struct ui_digit_atlas *a = d->atlas;
+    size_t n = strlen(buf);
+    bool same_layout = (n == strlen(d->txt));
+    for (size_t i = 0; same_layout && i < n; i++) {
+        same_layout = char_w(a, buf[i]) == char_w(a, d->txt[i]);
+    }
+
+    if (!same_layout) {
+        /* 宽度排布变了（如步数 99→100）：改宽度并整体重绘，居中对齐由 LVGL 重新计算 */
+        int32_t w = 0;
+        for (size_t i = 0; i < n; i++) w += char_w(a, buf[i]);
+        memcpy(d->txt, buf, sizeof(buf));
+        lv_obj_set_width(obj, w);
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    /* 排布不变：只失效内容变了的字符格，例如每秒只重绘秒的个位 */
+    int32_t x = obj->coords.x1;
+    for (size_t i = 0; i < n; i++) {
+        int32_t w = char_w(a, buf[i]);
+        if (buf[i] != d->txt[i]) {
+            lv_area_t cell = { x, obj->coords.y1, x + w - 1, obj->coords.y2 };
+            lv_obj_invalidate_area(obj, &cell);
+        }
+        x += w;
+    }
+    memcpy(d->txt, buf, sizeof(buf));
+}
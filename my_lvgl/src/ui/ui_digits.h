@@ -0,0 +1,28 @@
+#pragma once
+#include <lvgl.h>
+#include "ui_digit_atlas.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 数字控件：用图集精灵拼字符串，代替 Montserrat 标签显示时间/日期/步数。
+ *  - 每个字符是一块不透明图片，绘制就是从 flash 按行拷贝到绘制缓冲
+ *  - set_text 只失效内容变化的字符格；字符宽度排布变化时才失效整个控件
+ *  - 只支持图集里的字符（数字和少量分隔符），其余按空格画 */
+#ifndef UI_DIGITS_MAX
+#define UI_DIGITS_MAX   12
+#endif
+
+lv_obj_t *ui_digits_create(lv_obj_t *parent, const struct ui_digit_atlas *atlas);
+
+/* 超过 UI_DIGITS_MAX 的部分截掉 */
+void ui_digits_set_text(lv_obj_t *obj, const char *txt);
+
+/* 在 layer 上从 (x, y) 开始画 txt，返回画完后的 x；控件和基准测试共用 */
+int32_t ui_digits_draw(lv_layer_t *layer, const struct ui_digit_atlas *atlas,
+                       const char *txt, int32_t x, int32_t y);
+
+#ifdef __cplusplus
+}
+#endif
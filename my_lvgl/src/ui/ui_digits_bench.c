@@ -0,0 +1,115 @@
+// ui_digits_bench.c — 数字图集 vs Montserrat 标签的渲染开销对比：UI 线程首帧后跑一次
+//  同一段文字分别用 lv_draw_label（查字形 + 解压 + 抗锯齿混合）和 ui_digits_draw
+//  （不透明 RGB565 图片拷贝）画到离屏 canvas 上，两边都先铺背景，与屏上实际情况一致
+//  只测 CPU 渲染，不含 SPI 传输
+// 编译：west build -- -DUI_BENCH=ON -DCONFIG_TIMING_FUNCTIONS=y
+
+#include <stdio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/logging/log.h>
+
+#include "ui_digits.h"
+
+LOG_MODULE_REGISTER(ui_digits_bench, LOG_LEVEL_INF);
+
+#if !IS_ENABLED(CONFIG_TIMING_FUNCTIONS)
+#error "UI_BENCH needs CONFIG_TIMING_FUNCTIONS=y (DWT cycle counter)"
+#endif
+#if !LV_USE_CANVAS
+#error "UI_BENCH needs CONFIG_LV_USE_CANVAS=y"
+#endif
+
+#ifndef UI_BENCH_ROUNDS
+#define UI_BENCH_ROUNDS  200
+#endif
+#define UI_BENCH_W       160
+#define UI_BENCH_H       24
+
+LV_DRAW_BUF_DEFINE_STATIC(s_bench_buf, UI_BENCH_W, UI_BENCH_H, LV_COLOR_FORMAT_RGB565);
+
+typedef void (*bench_draw_fn)(lv_layer_t *layer, const struct ui_digit_atlas *a, const char *txt);
+
+static void fill_bg(lv_layer_t *layer, const struct ui_digit_atlas *a)
+{
+    lv_draw_rect_dsc_t r;
+    lv_draw_rect_dsc_init(&r);
+    r.bg_color = lv_color_hex(a->bg);
+    lv_area_t area = { 0, 0, UI_BENCH_W - 1, UI_BENCH_H - 1 };
+    lv_draw_rect(layer, &r, &area);
+}
+
+static void draw_label(lv_layer_t *layer, const struct ui_digit_atlas *a, const char *txt)
+{
+    fill_bg(layer, a);
+
+    lv_draw_label_dsc_t d;
+    lv_draw_label_dsc_init(&d);
+    d.font  = &lv_font_montserrat_18;
+    d.color = lv_color_hex(a->fg);
+    d.text  = txt;
+    d.text_local = 1;       /* txt 是栈上缓冲，让 LVGL 复制一份 */
+    lv_area_t area = { 0, 0, UI_BENCH_W - 1, a->h - 1 };
+    lv_draw_label(layer, &d, &area);
+}
+
+static void draw_atlas(lv_layer_t *layer, const struct ui_digit_atlas *a, const char *txt)
+{
+    fill_bg(layer, a);
+    (void)ui_digits_draw(layer, a, txt, 0, 0);
+}
+
+/* 每轮换一个值，避免任何一边因为内容不变占便宜 */
+static uint64_t run(lv_obj_t *canvas, bench_draw_fn fn, const struct ui_digit_atlas *a,
+                    const char *fmt, bool clock)
+{
+    char txt[16];
+    uint64_t cyc = 0;
+
+    for (uint32_t i = 0; i < UI_BENCH_ROUNDS; i++) {
+        if (clock) {
+            snprintf(txt, sizeof(txt), fmt, (i / 3600U) % 24U, (i / 60U) % 60U, i % 60U);
+        } else {
+            snprintf(txt, sizeof(txt), fmt, 10000U + i * 37U);
+        }
+
+        timing_t t0 = timing_counter_get();
+        lv_layer_t layer;
+        lv_canvas_init_layer(canvas, &layer);
+        fn(&layer, a, txt);
+        lv_canvas_finish_layer(canvas, &layer);
+        timing_t t1 = timing_counter_get();
+        cyc += timing_cycles_get(&t0, &t1);
+    }
+    return cyc / UI_BENCH_ROUNDS;
+}
+
+static void bench_case(lv_obj_t *canvas, const char *name, const struct ui_digit_atlas *a,
+                       const char *fmt, bool clock)
+{
+    uint64_t lbl = run(canvas, draw_label, a, fmt, clock);
+    uint64_t atl = run(canvas, draw_atlas, a, fmt, clock);
+
+    LOG_INF("%-6s label %u cyc (%u us), atlas %u cyc (%u us), x%u.%02u",
+            name, (uint32_t)lbl, (uint32_t)(timing_cycles_to_ns(lbl) / 1000U),
+            (uint32_t)atl, (uint32_t)(timing_cycles_to_ns(atl) / 1000U),
+            (uint32_t)(atl ? lbl / atl : 0), (uint32_t)(atl ? (lbl * 100U / atl) % 100U : 0));
+}
+
+void ui_digits_bench_run(void)
+{
+    LV_DRAW_BUF_INIT_STATIC(s_bench_buf);
+
+    lv_obj_t *canvas = lv_canvas_create(lv_screen_active());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_draw_buf(canvas, &s_bench_buf);
+
+    timing_init();
+    timing_start();
+
+    bench_case(canvas, "clock", &ui_atlas_clock, "%02u:%02u:%02u", true);
+    bench_case(canvas, "steps", &ui_atlas_steps, "%u", false);
+
+    timing_stop();
+    lv_obj_delete(canvas);
+}
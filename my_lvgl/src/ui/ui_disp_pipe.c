@@ -0,0 +1,150 @@
+#include "ui_disp_pipe.h"
+#include "ui_disp_stats.h"
+#include "ui_disp_te.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ui_disp_pipe, LOG_LEVEL_INF);
+
+#if IS_ENABLED(CONFIG_LV_Z_FLUSH_THREAD)
+#error "ui_disp_pipe replaces the Zephyr LVGL flush thread; set CONFIG_LV_Z_FLUSH_THREAD=n"
+#endif
+
+static const struct device *const s_disp_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+struct flush_req {
+    uint8_t *buf;
+    uint16_t x, y;
+    bool     te_sync;       /* 大帧的第一块：等 TE 再开始写 */
+    struct display_buffer_descriptor desc;
+};
+
+/* 双缓冲下同一时刻最多一块在传、一块在画，队列深度 2 足够 */
+K_MSGQ_DEFINE(s_flush_q, sizeof(struct flush_req), 2, 4);
+static K_SEM_DEFINE(s_flush_done, 0, 1);
+static atomic_t s_busy;         /* flush 线程手里有一块还没写完 */
+
+static K_THREAD_STACK_DEFINE(s_pipe_stack, UI_DISP_PIPE_STACK_SIZE);
+static struct k_thread s_pipe_thread;
+
+/* UI 线程：本帧脏区合计行数、下一次 flush 是否本帧第一块 */
+static uint32_t s_frame_lines;
+static bool     s_frame_first;
+
+static void pipe_thread(void *a, void *b, void *c)
+{
+    ARG_UNUSED(a); ARG_UNUSED(b); ARG_UNUSED(c);
+    struct flush_req r;
+
+    while (1) {
+        (void)k_msgq_get(&s_flush_q, &r, K_FOREVER);
+        atomic_set(&s_busy, 1);
+        uint32_t t0 = k_cycle_get_32();
+
+        /* 面板要大端 RGB565：交换放在这里做，不占渲染线程的时间 */
+        if (IS_ENABLED(CONFIG_LV_COLOR_16_SWAP)) {
+            lv_draw_sw_rgb565_swap(r.buf, r.desc.width * r.desc.height);
+        }
+        if (r.te_sync) {
+            (void)ui_disp_te_wait();
+        }
+        int err = display_write(s_disp_dev, r.x, r.y, &r.desc, r.buf);
+        if (err) {
+            LOG_ERR("display_write failed: %d", err);
+        }
+
+        ui_disp_stats_add_flush(k_cyc_to_us_floor32(k_cycle_get_32() - t0));
+        atomic_set(&s_busy, 0);
+        /* 不调 lv_display_flush_ready：flushing 标志留给 LVGL 在 wait_cb 之后自己清，
+         * 否则 LVGL 可能跳过 wait_cb，信号量多出一次，下一块缓冲会被提前复用 */
+        k_sem_give(&s_flush_done);
+    }
+}
+
+/* UI 线程：只排队，立即返回 */
+static void pipe_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    uint16_t w = (uint16_t)lv_area_get_width(area);
+    uint16_t h = (uint16_t)lv_area_get_height(area);
+
+    struct flush_req r = {
+        .buf = px_map,
+        .x   = (uint16_t)area->x1,
+        .y   = (uint16_t)area->y1,
+        .te_sync = s_frame_first && ui_disp_te_wanted(s_frame_lines),
+        .desc = {
+            .buf_size = (uint32_t)w * h * 2U,
+            .width    = w,
+            .height   = h,
+            .pitch    = w,
+            .frame_incomplete = !lv_display_flush_is_last(disp),
+        },
+    };
+    s_frame_first = false;
+    (void)k_msgq_put(&s_flush_q, &r, K_FOREVER);
+}
+
+/* UI 线程：脏区已合并、开始渲染前统计本帧大小，决定第一块要不要等 TE */
+static void pipe_render_start_cb(lv_event_t *e)
+{
+    lv_display_t *disp = lv_event_get_current_target(e);
+    uint32_t lines = 0;
+
+    for (uint32_t i = 0; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) {
+            lines += (uint32_t)lv_area_get_height(&disp->inv_areas[i]);
+        }
+    }
+    s_frame_lines = lines;
+    s_frame_first = true;
+}
+
+/* UI 线程：LVGL 要用的缓冲还在传，等 flush 线程放行 */
+static void pipe_wait_cb(lv_display_t *disp)
+{
+    ARG_UNUSED(disp);
+    uint32_t t0 = k_cycle_get_32();
+    (void)k_sem_take(&s_flush_done, K_FOREVER);
+    ui_disp_stats_add_stall(k_cyc_to_us_floor32(k_cycle_get_32() - t0));
+}
+
+void ui_disp_pipe_wait_idle(void)
+{
+    /* 只在 LVGL 停画之后用，队列不会再进新块；最多等两块传完 */
+    while (k_msgq_num_used_get(&s_flush_q) || atomic_get(&s_busy)) {
+        k_sleep(K_MSEC(1));
+    }
+}
+
+int ui_disp_pipe_init(lv_display_t *disp)
+{
+    if (!disp || !device_is_ready(s_disp_dev)) return -ENODEV;
+
+    if (lv_color_format_get_size(lv_display_get_color_format(disp)) != 2) {
+        LOG_ERR("only RGB565 is supported");
+        return -ENOTSUP;
+    }
+    if (!lv_display_is_double_buffered(disp)) {
+        /* 单缓冲也能跑，只是每块都要等传完才能接着画，没有重叠 */
+        LOG_WRN("single draw buffer: enable CONFIG_LV_Z_DOUBLE_VDB for render/transfer overlap");
+    }
+
+    k_thread_create(&s_pipe_thread, s_pipe_stack, K_THREAD_STACK_SIZEOF(s_pipe_stack),
+                    pipe_thread, NULL, NULL, NULL,
+                    UI_DISP_PIPE_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&s_pipe_thread, "disp_pipe");
+
+    (void)ui_disp_te_init();      /* 失败或没配 TE 节点：照常立即刷新 */
+    lv_display_add_event_cb(disp, pipe_render_start_cb, LV_EVENT_RENDER_START, NULL);
+
+    lv_display_set_flush_wait_cb(disp, pipe_wait_cb);
+    lv_display_set_flush_cb(disp, pipe_flush_cb);
+
+    LOG_INF("display pipe: %s buffer, %u B each",
+            lv_display_is_double_buffered(disp) ? "double" : "single",
+            (unsigned)disp->buf_1->data_size);
+    return 0;
+}
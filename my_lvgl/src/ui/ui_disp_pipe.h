@@ -0,0 +1,32 @@
+#pragma once
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 显示流水线：接管 Zephyr LVGL 胶水层的 flush，两块局部绘制缓冲轮流用
+ *  - 缓冲由 Zephyr 按 CONFIG_LV_Z_DOUBLE_VDB / CONFIG_LV_Z_VDB_SIZE 分配，这里只换回调
+ *  - flush_cb 只把区域交给 flush 线程就返回，LVGL 立刻去渲染另一块缓冲；
+ *    flush 线程做字节交换 + display_write（SPIM EasyDMA），与渲染重叠
+ *  - 配了面板 TE（ui_disp_te.h）时，大帧的第一块在字节交换后等 V-blank 再写
+ *  - LVGL 需要复用还在传输的缓冲时才在 flush_wait_cb 里等，等的时间记为 stall
+ * 各段耗时汇总到 ui_disp_stats */
+
+#ifndef UI_DISP_PIPE_PRIORITY
+#define UI_DISP_PIPE_PRIORITY   1       /* 高于 UI 线程：缓冲一交过来就开始传 */
+#endif
+#ifndef UI_DISP_PIPE_STACK_SIZE
+#define UI_DISP_PIPE_STACK_SIZE 1536
+#endif
+
+/* UI 线程在首帧渲染前调用 */
+int ui_disp_pipe_init(lv_display_t *disp);
+
+/* UI 线程：等已排队的块全部写完。绕过 LVGL 直接写屏（ui_aod）之前调用，
+ * 否则 flush 线程可能在后面把旧画面盖上去 */
+void ui_disp_pipe_wait_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
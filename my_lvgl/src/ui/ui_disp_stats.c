@@ -0,0 +1,102 @@
+#include "ui_disp_stats.h"
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ui_disp_stats, LOG_LEVEL_INF);
+
+static struct ui_disp_stats s_total;
+static uint8_t              s_px_size;
+static uint32_t             s_areas_at_ready;
+static atomic_t             s_flush_us;
+static uint32_t             s_refr_t0;
+static uint32_t             s_stall_at_start;
+static uint32_t             s_frame_max_us;     /* 区间内单帧最长（渲染 + stall），打印后清零 */
+
+static void refr_start_cb(lv_event_t *e)
+{
+    ARG_UNUSED(e);
+    s_refr_t0 = k_cycle_get_32();
+    s_stall_at_start = s_total.stall_us;
+}
+
+static void flush_start_cb(lv_event_t *e)
+{
+    const lv_area_t *area = lv_event_get_param(e);
+    if (!area) return;
+
+    uint32_t px = (uint32_t)lv_area_get_size(area);
+    s_total.areas++;
+    s_total.pixels += px;
+    s_total.bytes  += px * s_px_size;
+}
+
+static void refr_ready_cb(lv_event_t *e)
+{
+    ARG_UNUSED(e);
+    /* 刷新定时器每次跑完都会发 REFR_READY，没有脏区的空跑不算一帧 */
+    if (s_total.areas == s_areas_at_ready) return;
+
+    uint32_t dur   = k_cyc_to_us_floor32(k_cycle_get_32() - s_refr_t0);
+    uint32_t stall = s_total.stall_us - s_stall_at_start;
+
+    s_total.frames++;
+    s_total.render_us += (dur > stall) ? (dur - stall) : 0U;
+    s_frame_max_us = MAX(s_frame_max_us, dur);
+    s_areas_at_ready = s_total.areas;
+}
+
+#if UI_DISP_STATS_LOG_S > 0
+static struct ui_disp_stats s_last;
+
+/* 只打印有刷新的区间，静止时不刷日志 */
+static void log_timer_cb(lv_timer_t *t)
+{
+    ARG_UNUSED(t);
+    struct ui_disp_stats now;
+    ui_disp_stats_get(&now);
+    if (now.areas == s_last.areas) return;
+
+    uint32_t n = MAX(now.frames - s_last.frames, 1U);
+    LOG_INF("flush/%ds: frames=%u areas=%u px=%u bytes=%u", UI_DISP_STATS_LOG_S,
+            now.frames - s_last.frames, now.areas - s_last.areas,
+            now.pixels - s_last.pixels, now.bytes - s_last.bytes);
+    LOG_INF("  per frame: render %u us, flush %u us, stall %u us, worst %u us",
+            (now.render_us - s_last.render_us) / n, (now.flush_us - s_last.flush_us) / n,
+            (now.stall_us - s_last.stall_us) / n, s_frame_max_us);
+    s_last = now;
+    s_frame_max_us = 0;
+}
+#endif
+
+void ui_disp_stats_init(lv_display_t *disp)
+{
+    if (!disp) return;
+
+    s_px_size = lv_color_format_get_size(lv_display_get_color_format(disp));
+    lv_display_add_event_cb(disp, flush_start_cb, LV_EVENT_FLUSH_START, NULL);
+    lv_display_add_event_cb(disp, refr_start_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+
+#if UI_DISP_STATS_LOG_S > 0
+    lv_timer_create(log_timer_cb, UI_DISP_STATS_LOG_S * 1000U, NULL);
+#endif
+}
+
+void ui_disp_stats_get(struct ui_disp_stats *out)
+{
+    if (!out) return;
+    memcpy(out, &s_total, sizeof(*out));
+    out->flush_us = (uint32_t)atomic_get(&s_flush_us);
+}
+
+void ui_disp_stats_add_flush(uint32_t us)
+{
+    (void)atomic_add(&s_flush_us, (atomic_val_t)us);
+}
+
+void ui_disp_stats_add_stall(uint32_t us)
+{
+    s_total.stall_us += us;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include <lvgl.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 刷屏统计：挂在 LVGL 显示的刷新事件上，累计每次送往面板的区域与各段耗时。
+ * 除 flush_us 由 flush 线程原子累加外，都只在 UI 线程更新/读取，不加锁。
+ * 时间均为累计微秒，按区间相减使用（回绕无妨） */
+struct ui_disp_stats {
+    uint32_t frames;        /* 真正送过数据的刷新周期数 */
+    uint32_t areas;         /* flush 次数（一个周期可能多块） */
+    uint32_t pixels;
+    uint32_t bytes;         /* pixels × 每像素字节数，≈ SPI 有效载荷 */
+    uint32_t render_us;     /* UI 线程渲染：刷新周期耗时减去 stall */
+    uint32_t flush_us;      /* flush 线程：字节交换 + display_write（SPI 传输） */
+    uint32_t stall_us;      /* UI 线程等待缓冲空出来的时间，0 表示渲染与传输完全重叠 */
+};
+
+/* 每隔多少秒打印一次区间统计；0 = 不打印，只累计 */
+#ifndef UI_DISP_STATS_LOG_S
+#define UI_DISP_STATS_LOG_S   0
+#endif
+
+/* UI 线程在首帧渲染前调用 */
+void ui_disp_stats_init(lv_display_t *disp);
+
+/* 自启动以来的累计值（UI 线程调用） */
+void ui_disp_stats_get(struct ui_disp_stats *out);
+
+/* 由 ui_disp_pipe 上报：flush 线程每传完一块、UI 线程每等完一次 */
+void ui_disp_stats_add_flush(uint32_t us);
+void ui_disp_stats_add_stall(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+#include "ui_disp_te.h"
+
+#if UI_DISP_TE_ENABLED
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/mipi_dbi.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(ui_disp_te, LOG_LEVEL_INF);
+
+#define TE_NODE       DT_COMPAT_GET_ANY_STATUS_OKAY(app_display_te)
+#define TE_PANEL      DT_PHANDLE(TE_NODE, display)
+#define TE_MIN_LINES  DT_PROP(TE_NODE, min_lines)
+#define TE_TIMEOUT_MS DT_PROP(TE_NODE, timeout_ms)
+#define TE_MAX_MISSES DT_PROP(TE_NODE, max_misses)
+
+#define ST7789_CMD_TEON  0x35
+#define TEON_VBLANK_ONLY 0x00
+
+static const struct gpio_dt_spec s_te = GPIO_DT_SPEC_GET(TE_NODE, gpios);
+static const struct device *const s_dbi = DEVICE_DT_GET(DT_PARENT(TE_PANEL));
+static const struct mipi_dbi_config s_dbi_cfg =
+    MIPI_DBI_CONFIG_DT(TE_PANEL, SPI_OP_MODE_MASTER | SPI_WORD_SET(8), 0);
+
+static struct gpio_callback s_te_cb;
+static K_SEM_DEFINE(s_te_sem, 0, 1);
+static bool     s_active;       /* 初始化成功且没因连续超时放弃 */
+static uint16_t s_misses;
+
+static void te_isr(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins)
+{
+    ARG_UNUSED(port); ARG_UNUSED(cb); ARG_UNUSED(pins);
+    k_sem_give(&s_te_sem);
+}
+
+int ui_disp_te_init(void)
+{
+    if (!gpio_is_ready_dt(&s_te) || !device_is_ready(s_dbi)) {
+        LOG_WRN("TE gpio or MIPI-DBI bus not ready, flushing without TE");
+        return -ENODEV;
+    }
+
+    int err = gpio_pin_configure_dt(&s_te, GPIO_INPUT);
+    if (!err) {
+        gpio_init_callback(&s_te_cb, te_isr, BIT(s_te.pin));
+        err = gpio_add_callback_dt(&s_te, &s_te_cb);
+    }
+    if (!err) {
+        const uint8_t mode = TEON_VBLANK_ONLY;
+        err = mipi_dbi_command_write(s_dbi, &s_dbi_cfg, ST7789_CMD_TEON, &mode, 1);
+    }
+    if (err) {
+        LOG_ERR("TE init failed: %d", err);
+        return err;
+    }
+
+    s_active = true;
+    LOG_INF("TE sync on %s.%u: frames >= %u lines, timeout %u ms",
+            s_te.port->name, s_te.pin, TE_MIN_LINES, TE_TIMEOUT_MS);
+    return 0;
+}
+
+bool ui_disp_te_wanted(uint32_t frame_lines)
+{
+    return s_active && frame_lines >= TE_MIN_LINES;
+}
+
+bool ui_disp_te_wait(void)
+{
+    if (!s_active) return false;
+
+    /* 只在等的这一小段开中断：上升沿 = 进入 V-blank，之前残留的信号量作废 */
+    k_sem_reset(&s_te_sem);
+    (void)gpio_pin_interrupt_configure_dt(&s_te, GPIO_INT_EDGE_TO_ACTIVE);
+    int err = k_sem_take(&s_te_sem, K_MSEC(TE_TIMEOUT_MS));
+    (void)gpio_pin_interrupt_configure_dt(&s_te, GPIO_INT_DISABLE);
+
+    if (err == 0) {
+        s_misses = 0;
+        return true;
+    }
+
+    s_misses++;
+    if (TE_MAX_MISSES > 0 && s_misses >= TE_MAX_MISSES) {
+        s_active = false;
+        LOG_WRN("no TE edge for %u frames, TE sync disabled", s_misses);
+    }
+    return false;
+}
+
+#endif /* UI_DISP_TE_ENABLED */
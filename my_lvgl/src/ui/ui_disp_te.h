@@ -0,0 +1,39 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/devicetree.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 面板 TE（tearing effect）同步：devicetree 里有 okay 的 "app,display-te" 节点才编进来。
+ *  - init 时给面板发 TEON（只在 V-blank 输出 TE 脉冲）
+ *  - flush 线程在大帧的第一块传输前等 TE 上升沿（GPIOTE），帧从扫描刚结束处开始写
+ *  - 只在等的时候开引脚中断，平时 60Hz 的 TE 脉冲不唤醒 CPU
+ *  - 超时照常刷新；连续超时 max-misses 次视为没接线，之后不再等
+ * 参数见 dts/bindings/app,display-te.yaml */
+#define UI_DISP_TE_ENABLED DT_HAS_COMPAT_STATUS_OKAY(app_display_te)
+
+#if UI_DISP_TE_ENABLED
+
+/* UI 线程，在第一次 flush 之前调用 */
+int  ui_disp_te_init(void);
+
+/* 脏区合计 frame_lines 行的一帧是否需要等 TE（TE 可用且帧足够大） */
+bool ui_disp_te_wanted(uint32_t frame_lines);
+
+/* flush 线程：等下一个 TE 上升沿，超时返回 false */
+bool ui_disp_te_wait(void);
+
+#else
+
+static inline int  ui_disp_te_init(void) { return 0; }
+static inline bool ui_disp_te_wanted(uint32_t frame_lines) { (void)frame_lines; return false; }
+static inline bool ui_disp_te_wait(void) { return false; }
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,56 @@
+// ui_mailbox.c — 跨线程 UI 更新：原子槽位 + 待处理位图，取代逐次 lv_async_call
+//  lv_async_call 每次都从 LVGL 堆分配一个单次定时器，传感器发得越快分配越多，
+//  同一个值在一帧内也会重绘多次；这里投递不分配，UI 线程一轮只处理每个字段一次
+#include "ui_mailbox.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+#include "ui_app.h"
+#include "ui_main_view.h"
+#include "ui_time_display.h"
+#include "ui_steps_display.h"
+
+BUILD_ASSERT(UI_MB_FIELD_COUNT <= 32, "pending bitmap is one atomic_t");
+
+static atomic_t s_val[UI_MB_FIELD_COUNT];
+static atomic_t s_pending = ATOMIC_INIT(0);
+
+void ui_mailbox_put(enum ui_mb_field f, uint32_t val)
+{
+    /* 先写值再置位：UI 线程看到位时值一定已经就绪 */
+    atomic_set(&s_val[f], (atomic_val_t)val);
+    atomic_or(&s_pending, BIT(f));
+}
+
+void ui_mailbox_post(enum ui_mb_field f, uint32_t val)
+{
+    ui_mailbox_put(f, val);
+    ui_app_kick();
+}
+
+uint32_t ui_mailbox_get(enum ui_mb_field f)
+{
+    return (uint32_t)atomic_get(&s_val[f]);
+}
+
+void ui_mailbox_drain(void)
+{
+    /* 先清位再读值：清位之后到来的投递会重新置位，下一轮再处理，不会丢 */
+    uint32_t pend = (uint32_t)atomic_clear(&s_pending);
+    if (!pend) return;
+
+    if (pend & BIT(UI_MB_GO_HOME)) {
+        ui_main_view_go_home();
+    }
+    if (pend & BIT(UI_MB_TIME)) {
+        ui_time_display_update();
+    }
+    if (pend & BIT(UI_MB_STEPS)) {
+        ui_steps_display_update();
+    }
+    if (pend & (BIT(UI_MB_DIST_M) | BIT(UI_MB_KCAL_X10))) {
+        ui_steps_display_update_metrics();
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* UI 更新邮箱：其他线程（zbus 监听者、work 队列、ISR）给 UI 的更新都投到这里。
+ * 每个字段一个原子槽位 + 一个“待处理”位图：投递只是两次原子写加一次唤醒，
+ * 不分配内存、不加锁；同一字段在 UI 线程取走之前多次投递只保留最新值（后写者胜）。
+ * UI 线程每轮循环（渲染前）取一次，每个字段最多处理一次 */
+enum ui_mb_field {
+    UI_MB_GO_HOME,          /* 回表盘；值无意义 */
+    UI_MB_TIME,             /* 系统时间被设置，立即刷新时钟；值无意义 */
+    UI_MB_STEPS,            /* 累计步数 */
+    UI_MB_DIST_M,           /* 距离（米）    ┐ 一起投递， */
+    UI_MB_KCAL_X10,         /* 热量（0.1kcal）┘ 一起重绘 */
+    UI_MB_FIELD_COUNT,
+};
+
+/* 任意上下文：写入最新值并唤醒 UI 线程 */
+void ui_mailbox_post(enum ui_mb_field f, uint32_t val);
+
+/* 任意上下文：只写值不唤醒，用于成组投递的前几项，最后一项用 ui_mailbox_post */
+void ui_mailbox_put(enum ui_mb_field f, uint32_t val);
+
+/* 读某字段的最新值（任意线程；UI 重建控件时用它补显示） */
+uint32_t ui_mailbox_get(enum ui_mb_field f);
+
+/* UI 线程每轮循环调用一次：取走待处理位图并分发 */
+void ui_mailbox_drain(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,25 +6,37 @@
 /* ------- screens ------- */
 static lv_obj_t* scr_main = NULL;
 static lv_obj_t* scr_menu = NULL;
+static lv_obj_t* s_tv = NULL;        /* 主屏 tileview 与中心表盘，供“回表盘”使用 */
+static lv_obj_t* s_home = NULL;
+
+/* 各页内容的粗略 LVGL 堆占用（字节），计入 watch_tileview 的懒加载预算 */
+#define TILE_COST_TITLE   320     /* 一个居中标题 */
+#define TILE_COST_FACE    1024    /* 时间 + 日期精灵控件、1s 定时器 */
+#define TILE_COST_STEPS   1024    /* 步数精灵控件 + 距离/热量标签 */
+#define TILE_COST_UP      2048    /* 按钮 + 标签 + 滑条 */
 
 /* ------- fwd decls ------- */
 static void on_open_menu(lv_event_t* e);
 
 static void build_scr_menu(void);
 static void build_scr_main(void);
-static void fill_tile(lv_obj_t* tile, const char* title, lv_color_t color);
+static void paint_tile(lv_obj_t* tile, lv_color_t color);
 static void add_open_button_to_up(lv_obj_t* up_tile);
 
 /* ========================================================= */
-/*  Only paint background + title on a tile (no buttons here) */
+/*  Tile background stays on the tile; content is lazy      */
 /* ========================================================= */
-static void fill_tile(lv_obj_t* tile, const char* title, lv_color_t color)
+static void paint_tile(lv_obj_t* tile, lv_color_t color)
 {
     lv_obj_set_style_bg_color(tile, color, 0);
     lv_obj_set_style_bg_opa(tile, LV_OPA_COVER, 0);
+}
 
+/* 页面工厂：user_data 是标题字符串（静态） */
+static void build_title(lv_obj_t* tile, void* user_data)
+{
     lv_obj_t* label = lv_label_create(tile);
-    lv_label_set_text(label, title);
+    lv_label_set_text_static(label, (const char*)user_data);
     lv_obj_center(label);
 }
 
@@ -60,24 +72,47 @@ static void add_open_button_to_up(lv_obj_t* up_tile)
     lv_obj_align(slider, LV_ALIGN_BOTTOM_MID, 0, -10);
 }
 
-static void add_time_display(lv_obj_t* tile)
+static void build_face(lv_obj_t* tile, void* user_data)
 {
+    build_title(tile, user_data);
     ui_time_display_init(tile);
 }
 
-static void add_steps_display(lv_obj_t* tile)
+static void build_steps(lv_obj_t* tile, void* user_data)
 {
+    build_title(tile, user_data);
     ui_steps_display_init(tile);
 }
 
+static void free_steps(lv_obj_t* tile, void* user_data)
+{
+    ARG_UNUSED(tile); ARG_UNUSED(user_data);
+    ui_steps_display_deinit();
+}
+
+static void build_up(lv_obj_t* tile, void* user_data)
+{
+    build_title(tile, user_data);
+    add_open_button_to_up(tile);
+}
+
 /* ========================================================= */
 /*  Menu screen: a simple back button                        */
 /* ========================================================= */
+static void on_menu_deleted(lv_event_t* e)
+{
+    ARG_UNUSED(e);
+    scr_menu = NULL;
+}
+
 static void build_scr_menu(void)
 {
-    if (scr_menu && lv_obj_is_valid(scr_menu)) return;   // 已创建就不重复
+    if (scr_menu) return;                                // 已创建就不重复
     scr_menu = lv_obj_create(NULL);                      // 一定要创建屏幕
     lv_obj_clear_flag(scr_menu, LV_OBJ_FLAG_SCROLLABLE);
+    /* 返回主屏时 back_main_view 让 LVGL 自动删掉菜单屏；删时清指针，下次打开重建。
+     * 不能靠 lv_obj_is_valid 判断：已释放的地址可能被新对象复用 */
+    lv_obj_add_event_cb(scr_menu, on_menu_deleted, LV_EVENT_DELETE, NULL);
     ui_create_sleep_setting_page(scr_menu);
 }
 
@@ -127,19 +162,34 @@ static void build_scr_main(void)
     lv_obj_t* up = tiles[idx_up];
     lv_obj_t* down = tiles[idx_down];
 
-    /* 4) Paint each tile (no buttons here) */
-    fill_tile(center, "CENTER", lv_palette_main(LV_PALETTE_BLUE));
-    fill_tile(left, "LEFT", lv_palette_main(LV_PALETTE_GREY));
-    fill_tile(right, "RIGHT", lv_palette_main(LV_PALETTE_TEAL));
-    fill_tile(up, "UP", lv_palette_main(LV_PALETTE_ORANGE));
-    fill_tile(down, "DOWN", lv_palette_main(LV_PALETTE_RED));
-
-    /* 5) Only UP gets the "Open Menu" button (and it's non-focusable) */
-    add_open_button_to_up(up);
-    add_time_display(center);
-    add_steps_display(left);
-    /* 6) Force start at center as the last step (no animation, no jump) */
+    /* 4) Paint each tile; ui_digits 图集的背景色与这里对应（ui/CMakeLists.txt） */
+    paint_tile(center, lv_palette_main(LV_PALETTE_BLUE));
+    paint_tile(left, lv_palette_main(LV_PALETTE_GREY));
+    paint_tile(right, lv_palette_main(LV_PALETTE_TEAL));
+    paint_tile(up, lv_palette_main(LV_PALETTE_ORANGE));
+    paint_tile(down, lv_palette_main(LV_PALETTE_RED));
+
+    /* 5) 内容按需创建：靠近视口时建，离开够久后释放；表盘常驻 */
+    watch_tileview_set_tile_factory(tv, center, build_face, NULL, "CENTER",
+                                    TILE_COST_TITLE + TILE_COST_FACE);
+    watch_tileview_pin_tile(center, true);
+    watch_tileview_set_tile_factory(tv, left, build_steps, free_steps, "LEFT",
+                                    TILE_COST_TITLE + TILE_COST_STEPS);
+    watch_tileview_set_tile_factory(tv, right, build_title, NULL, "RIGHT", TILE_COST_TITLE);
+    watch_tileview_set_tile_factory(tv, up, build_up, NULL, "UP",
+                                    TILE_COST_TITLE + TILE_COST_UP);
+    watch_tileview_set_tile_factory(tv, down, build_title, NULL, "DOWN", TILE_COST_TITLE);
+
+    /* 页面内容都是静态的：滑动时用快照代替控件树绘制 */
+    for (size_t i = 0; i < ARRAY_SIZE(tiles); i++) {
+        watch_tileview_set_tile_snapshot(tiles[i], true);
+    }
+
+    /* 6) Force start at center as the last step (no animation, no jump);
+     *    中心页此时建好，四个相邻页在首帧之后预建 */
     watch_tileview_set_start_tile(tv, center);
+    s_tv = tv;
+    s_home = center;
 }
 
 /* ========================================================= */
@@ -163,6 +213,17 @@ void back_main_view(lv_event_t* e)
 /*  Public entry                                             */
 /* ========================================================= */
 
+void ui_main_view_go_home(void)
+{
+    if (!scr_main) return;
+    if (lv_screen_active() != scr_main) {
+        back_main_view(NULL);
+    }
+    if (watch_tileview_get_tile_act(s_tv) != s_home) {
+        watch_tileview_set_tile(s_tv, s_home, LV_ANIM_ON);
+    }
+}
+
 void ui_show_main_with_watch_tileview(void)
 {
     build_scr_main();
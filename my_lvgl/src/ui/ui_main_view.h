@@ -3,5 +3,7 @@
 
 void ui_show_main_with_watch_tileview(void);
 void back_main_view(lv_event_t* e);
+/* 回到主屏中心表盘（LVGL 线程调用） */
+void ui_main_view_go_home(void);
 
 #endif
\ No newline at end of file
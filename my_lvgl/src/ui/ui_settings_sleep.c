@@ -1,6 +1,7 @@
 // ui_settings_sleep.c
 #include "ui_settings_sleep.h"
 #include "ui_main_view.h"
+#include "app/backlight_ctrl.h"
 #include <zephyr/logging/log.h>
 #include <lvgl.h>
 LOG_MODULE_REGISTER(ui_sleep, LOG_LEVEL_INF);
@@ -21,6 +22,7 @@ static const uint16_t k_opt_sec[] = {10, 20, 30, 40, 50, 0};
 #define OPT_COUNT (sizeof(k_opt_sec)/sizeof(k_opt_sec[0]))
 
 static lv_obj_t *s_roller;
+static lv_obj_t *s_aod_sw;
 
 // —— 点击“确认”：仅保存并返回（不再调用 blctl_wake）——
 static void on_confirm_clicked(lv_event_t *e)
@@ -31,6 +33,7 @@ static void on_confirm_clicked(lv_event_t *e)
 
     uint32_t sec = k_opt_sec[idx];
     blctl_set_timeout(sec, true);   // 持久化保存；backlight_ctrl 内部负责重排auto-off
+    blctl_set_aod(lv_obj_has_state(s_aod_sw, LV_STATE_CHECKED), true);   // 超时后转常亮时钟
 
     // 返回主界面
     back_main_view(e);
@@ -39,6 +42,17 @@ static void on_confirm_clicked(lv_event_t *e)
 
 lv_obj_t * ui_create_sleep_setting_page(lv_obj_t *parent)
 {
+    // 常亮时钟开关（顶部）：超时熄屏后保留低亮度的分钟时钟
+    lv_obj_t *aod_label = lv_label_create(parent);
+    lv_label_set_text(aod_label, "AOD");
+    lv_obj_align(aod_label, LV_ALIGN_TOP_LEFT, 20, 18);
+
+    s_aod_sw = lv_switch_create(parent);
+    lv_obj_align(s_aod_sw, LV_ALIGN_TOP_RIGHT, -20, 10);
+    if (blctl_get_aod()) {
+        lv_obj_add_state(s_aod_sw, LV_STATE_CHECKED);
+    }
+
     // Roller
     s_roller = lv_roller_create(parent);
     lv_roller_set_options(s_roller, opt_str, LV_ROLLER_MODE_NORMAL);
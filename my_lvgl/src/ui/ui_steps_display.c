@@ -1,41 +1,83 @@
 #include "ui_steps_display.h"
-#include <zephyr/sys/atomic.h>
+#include "ui_mailbox.h"
+#include "ui_digits.h"
+#include "lv_watch_tileview.h"
+#include <errno.h>
+#include <stdio.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(ui_steps_display, LOG_LEVEL_INF);
 
+/* 最新值都在 ui_mailbox 的槽位里，这里只有控件和上次画过的值 */
 static lv_obj_t *s_steps_label;
-static atomic_t  s_latest_steps = ATOMIC_INIT(0);
 static uint32_t  s_last_drawn   = 0;
 
+/* 距离/热量：由 step_metrics 算好后推送，这里只负责显示 */
+static lv_obj_t *s_metrics_label;
+
 static void _do_update(void){
     if(!s_steps_label) {
-        LOG_WRN("steps label not ready yet");
+        LOG_DBG("steps page not built, keep latest only");
         return;
     }
-    uint32_t steps = (uint32_t)atomic_get(&s_latest_steps);
+    uint32_t steps = ui_mailbox_get(UI_MB_STEPS);
     if (steps == s_last_drawn) {
         LOG_DBG("steps unchanged: %u (skip draw)", (unsigned)steps);
         return;
     }
     s_last_drawn = steps;
-    lv_label_set_text_fmt(s_steps_label, "%u", steps);
+
+    char buf[12];
+    snprintf(buf, sizeof(buf), "%u", steps);
+    ui_digits_set_text(s_steps_label, buf);
+    watch_tileview_invalidate_snapshot(s_steps_label);   /* 步数页多半不在屏上 */
     LOG_DBG("steps label updated: %u", (unsigned)steps);
 }
 
-static void _async_cb(void *user){ (void)user; _do_update(); }
+static void _do_update_metrics(void){
+    if(!s_metrics_label) return;
+    uint32_t m    = ui_mailbox_get(UI_MB_DIST_M);
+    uint32_t kcal = ui_mailbox_get(UI_MB_KCAL_X10);
+    lv_label_set_text_fmt(s_metrics_label, "%u.%02u km  %u kcal",
+                          m / 1000U, (m % 1000U) / 10U, kcal / 10U);
+    watch_tileview_invalidate_snapshot(s_metrics_label);
+}
+
 
 int ui_steps_display_init(lv_obj_t *parent){
-    s_steps_label = lv_label_create(parent);
+    /* 步数用图集精灵控件（灰色左页），宽度随位数变化但始终居中 */
+    s_steps_label = ui_digits_create(parent, &ui_atlas_steps);
+    if (!s_steps_label) return -ENOMEM;
     lv_obj_align(s_steps_label, LV_ALIGN_CENTER, 0, 10);
-    lv_label_set_text(s_steps_label, "0");
+    ui_digits_set_text(s_steps_label, "0");
     s_last_drawn = 0;
-    LOG_INF("steps label created: %p", s_steps_label);
+    LOG_INF("steps sprites created: %p", s_steps_label);
     _do_update();
+
+    /* 步数控件宽度会变，不用 align_to（只按创建时的位置算一次），直接按中心偏移放在其下方 8px */
+    s_metrics_label = lv_label_create(parent);
+    const lv_font_t *f = lv_obj_get_style_text_font(s_metrics_label, LV_PART_MAIN);
+    lv_obj_align(s_metrics_label, LV_ALIGN_CENTER, 0,
+                 10 + ui_atlas_steps.h / 2 + 8 + lv_font_get_line_height(f) / 2);
+    _do_update_metrics();
     return 0;
 }
 
+void ui_steps_display_deinit(void){
+    s_steps_label   = NULL;
+    s_metrics_label = NULL;
+    s_last_drawn    = 0;
+}
+
 void ui_steps_display_set_latest(uint32_t steps){
-    atomic_set(&s_latest_steps, (atomic_val_t)steps);
     LOG_DBG("ui request to show steps=%u", (unsigned)steps);
-    lv_async_call(_async_cb, NULL);  /* 切回 UI 线程更新 */
+    ui_mailbox_post(UI_MB_STEPS, steps);    /* UI 线程下一轮取走，期间再来的只留最新 */
+}
+
+void ui_steps_display_set_metrics(uint32_t distance_m, uint32_t kcal_x10){
+    ui_mailbox_put(UI_MB_DIST_M, distance_m);
+    ui_mailbox_post(UI_MB_KCAL_X10, kcal_x10);
 }
+
+void ui_steps_display_update(void){ _do_update(); }
+
+void ui_steps_display_update_metrics(void){ _do_update_metrics(); }
@@ -5,6 +5,13 @@
 #include <stdint.h>
 
 int  ui_steps_display_init(lv_obj_t *parent);
+/* 所在页被懒加载回收时调用（控件随页删除）：只清指针，数据继续缓存，重建时直接显示最新值 */
+void ui_steps_display_deinit(void);
+/* 任意线程：投到 ui_mailbox */
 void ui_steps_display_set_latest(uint32_t steps);
+void ui_steps_display_set_metrics(uint32_t distance_m, uint32_t kcal_x10);
+/* UI 线程（ui_mailbox_drain）：按邮箱里的最新值重绘；页面没建时什么也不做 */
+void ui_steps_display_update(void);
+void ui_steps_display_update_metrics(void);
 
 #endif
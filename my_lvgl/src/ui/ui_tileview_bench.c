@@ -0,0 +1,70 @@
+// ui_tileview_bench.c — 环形主轴换页开销：主轴页数 4/12/24 各跑一遍，UI 线程首帧后跑一次
+//  在一个不加载的离屏 screen 上建 watch_tileview，反复 watch_tileview_set_tile 到右邻页
+//  （无动画），到端后每一步都要绕回；计时包含随后的 lv_obj_update_layout，
+//  即被搬动页的布局重算也算在内。只测 CPU，不含渲染和 SPI
+// 编译：west build -- -DUI_BENCH=ON -DCONFIG_TIMING_FUNCTIONS=y
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/logging/log.h>
+
+#include "lv_watch_tileview.h"
+
+LOG_MODULE_REGISTER(ui_tileview_bench, LOG_LEVEL_INF);
+
+#if !IS_ENABLED(CONFIG_TIMING_FUNCTIONS)
+#error "UI_BENCH needs CONFIG_TIMING_FUNCTIONS=y (DWT cycle counter)"
+#endif
+
+#ifndef UI_BENCH_SWIPES
+#define UI_BENCH_SWIPES  100
+#endif
+#define UI_BENCH_MAX_MAIN 24
+
+static void bench_case(uint8_t main_cnt)
+{
+    lv_obj_t *tiles[UI_BENCH_MAX_MAIN];
+    /* 中心页左右各一半，不要横向页 */
+    const uint8_t cnts[4] = { (main_cnt - 1) / 2, main_cnt / 2, 0, 0 };
+
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_obj_t *tv  = watch_tileview_create(scr);
+    watch_tileview_add_tiles(tv, tiles, cnts, LV_DIR_HOR, true, false);
+    watch_tileview_set_start_tile(tv, tiles[cnts[0]]);
+    lv_obj_update_layout(scr);
+
+    uint64_t cyc = 0, worst = 0;
+    for (uint32_t i = 0; i < UI_BENCH_SWIPES; i++) {
+        /* 主轴页的子对象下标就是环上的顺序，下一个下标即右邻页 */
+        uint32_t k = lv_obj_get_index(watch_tileview_get_tile_act(tv));
+        lv_obj_t *next = lv_obj_get_child(tv, (k + 1U) % main_cnt);
+
+        timing_t t0 = timing_counter_get();
+        (void)watch_tileview_set_tile(tv, next, LV_ANIM_OFF);
+        lv_obj_update_layout(scr);
+        timing_t t1 = timing_counter_get();
+
+        uint64_t c = timing_cycles_get(&t0, &t1);
+        cyc += c;
+        worst = MAX(worst, c);
+    }
+
+    LOG_INF("main=%2u  avg %u cyc (%u us), worst %u us", main_cnt,
+            (uint32_t)(cyc / UI_BENCH_SWIPES),
+            (uint32_t)(timing_cycles_to_ns(cyc / UI_BENCH_SWIPES) / 1000U),
+            (uint32_t)(timing_cycles_to_ns(worst) / 1000U));
+
+    lv_obj_delete(scr);
+}
+
+void ui_tileview_bench_run(void)
+{
+    timing_init();
+    timing_start();
+
+    bench_case(4);
+    bench_case(12);
+    bench_case(UI_BENCH_MAX_MAIN);
+
+    timing_stop();
+}
@@ -6,11 +6,22 @@ LOG_MODULE_REGISTER(ui_time_display, LOG_LEVEL_INF);
 #include <zephyr/posix/time.h>
 #include <stdio.h>
 
+#include "ui_mailbox.h"
+#include "ui_app.h"
+#include "ui_digits.h"
+#include "lv_watch_tileview.h"
 
-static lv_obj_t   *s_time_label;
-static lv_obj_t   *s_date_label;
+
+/* 时间/日期用图集精灵控件：字符定宽，每秒只失效变化的那一两个字符格，
+ * 而不是整屏（240×280×2 ≈ 134KB 的 SPI 传输），绘制也只是从 flash 拷贝像素 */
+static lv_obj_t   *s_time;
+static lv_obj_t   *s_date;
 static lv_timer_t *s_timer;
 
+/* 上次画到屏上的日期；-1 = 当前显示的是占位符 */
+static int s_shown_yday = -1;
+static int s_shown_year = -1;
+
 /* —— 从 CLOCK_REALTIME 读当前 epoch（秒） —— */
 static bool read_realtime(time_t *out)
 {
@@ -22,39 +33,51 @@ static bool read_realtime(time_t *out)
     return false;
 }
 
+static void show_placeholder(void)
+{
+    ui_digits_set_text(s_time, "--:--:--");
+    ui_digits_set_text(s_date, "----/--/--");
+    watch_tileview_invalidate_snapshot(s_date);
+    s_shown_yday = s_shown_year = -1;
+}
+
 /* —— 画面更新：只用 CLOCK_REALTIME —— */
 static void do_update_labels(void)
 {
-    if (!s_time_label || !s_date_label) return;
+    if (!s_time || !s_date) return;
 
     time_t now;
     if (!read_realtime(&now)) {
         /* 时钟尚未设置成功（或未启用 POSIX 时钟） */
-        lv_label_set_text(s_time_label, "--:--:--");
-        lv_label_set_text(s_date_label, "----/--/--");
+        show_placeholder();
         LOG_WRN("clock_gettime(CLOCK_REALTIME) failed");
         return;
     }
 
     struct tm tm_local;
     if (!localtime_r(&now, &tm_local)) {
-        lv_label_set_text(s_time_label, "--:--:--");
-        lv_label_set_text(s_date_label, "----/--/--");
+        show_placeholder();
         LOG_WRN("localtime_r failed");
         return;
     }
 
-    char tbuf[16], dbuf[20];
+    /* 控件自己比较新旧文字，只失效变化的字符格 */
+    char tbuf[12];
     snprintf(tbuf, sizeof(tbuf), "%02d:%02d:%02d",
              tm_local.tm_hour, tm_local.tm_min, tm_local.tm_sec);
-    snprintf(dbuf, sizeof(dbuf), "%04d-%02d-%02d",
-             tm_local.tm_year + 1900, tm_local.tm_mon + 1, tm_local.tm_mday);
-
-    lv_label_set_text(s_time_label, tbuf);
-    lv_label_set_text(s_date_label, dbuf);
-    lv_obj_invalidate(lv_screen_active());
-
-    //LOG_INF("Update UI: %s %s", dbuf, tbuf);
+    ui_digits_set_text(s_time, tbuf);
+
+    /* 日期只在跨天（或改时间跨天）时重算 */
+    if (tm_local.tm_yday != s_shown_yday || tm_local.tm_year != s_shown_year) {
+        char dbuf[20];
+        snprintf(dbuf, sizeof(dbuf), "%04d-%02d-%02d",
+                 tm_local.tm_year + 1900, tm_local.tm_mon + 1, tm_local.tm_mday);
+        ui_digits_set_text(s_date, dbuf);
+        /* 表盘不在屏上时的变化显示器看不到，要主动让滑动快照作废 */
+        watch_tileview_invalidate_snapshot(s_date);
+        s_shown_yday = tm_local.tm_yday;
+        s_shown_year = tm_local.tm_year;
+    }
 }
 
 /* LVGL 定时器：每秒刷新一次（运行在 LVGL 线程） */
@@ -64,28 +87,46 @@ static void timer_cb(lv_timer_t *t)
     do_update_labels();
 }
 
-/* 把“立即刷新”切回 LVGL 线程，避免跨线程操作 LVGL */
-static void _async_refresh(void *user) { ARG_UNUSED(user); do_update_labels(); }
+/* 屏幕不可见时暂停 1s 定时器；恢复时先补一次刷新再重新计时（LVGL 线程调用） */
+void ui_time_display_pause(bool pause)
+{
+    if (!s_timer) return;
+
+    if (pause) {
+        lv_timer_pause(s_timer);
+    } else {
+        do_update_labels();
+        lv_timer_reset(s_timer);
+        lv_timer_resume(s_timer);
+    }
+}
 
+/* 任意线程：经 ui_mailbox 切回 LVGL 线程，避免跨线程操作 LVGL */
 void ui_time_display_refresh(void)
 {
-    lv_async_call(_async_refresh, NULL);
+    ui_mailbox_post(UI_MB_TIME, 0);
+    ui_app_kick_aod();                  /* LVGL 暂停中的 AOD 时钟不经过邮箱 */
+}
+
+void ui_time_display_update(void)
+{
+    do_update_labels();
 }
 
-/* 初始化：两个标签 + 1s 定时器 */
+/* 初始化：时间 + 日期两个精灵控件 + 1s 定时器 */
 int ui_time_display_init(lv_obj_t* parent)
 {
-    s_time_label = lv_label_create(parent);
-    lv_obj_align(s_time_label, LV_ALIGN_CENTER, 0, -20);
-    lv_label_set_text(s_time_label, "--:--:--");
-    lv_obj_set_style_text_font(s_time_label, &lv_font_montserrat_18, LV_PART_MAIN);
-
-    s_date_label = lv_label_create(parent);
-    lv_obj_align(s_date_label,LV_ALIGN_CENTER, 0, 20);
-    lv_label_set_text(s_date_label, "----/--/--");
-    lv_obj_set_style_text_font(s_date_label, &lv_font_montserrat_18, LV_PART_MAIN);
+    s_time = ui_digits_create(parent, &ui_atlas_clock);
+    s_date = ui_digits_create(parent, &ui_atlas_clock);
+    if (!s_time || !s_date) return -ENOMEM;
+    lv_obj_align(s_time, LV_ALIGN_CENTER, 0, -20);
+    lv_obj_align(s_date, LV_ALIGN_CENTER, 0, 20);
+    /* 每秒都变：滑动时照常实时画，不进快照，也就不会每秒让表盘快照作废 */
+    watch_tileview_set_live(s_time, true);
+    show_placeholder();
+
     s_timer = lv_timer_create(timer_cb, 1000, NULL);
-    LOG_INF("UI time/date labels created, timer started");
+    LOG_INF("UI time/date sprites created, timer started");
 
     /* 启动时先刷一次（如果时钟没设过，会显示占位符并打印警告） */
     do_update_labels();
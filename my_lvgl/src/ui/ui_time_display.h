@@ -4,10 +4,15 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 int ui_time_display_init(lv_obj_t* parent);
-/* 立刻刷新一次（异步/同步皆可用在此演示） */
+/* 立刻刷新一次：任意线程，经 ui_mailbox 切到 LVGL 线程 */
 void ui_time_display_refresh(void);
+/* LVGL 线程：同步刷新（ui_mailbox_drain 调用） */
+void ui_time_display_update(void);
+/* 屏幕不可见时暂停 1s 定时器；false=恢复并立即刷新一次（LVGL 线程调用） */
+void ui_time_display_pause(bool pause);
 /* 来自 zbus 的“新时间”钩子：把 epoch 喂给 UI 作为锚点 */
 void ui_time_display_on_epoch(int64_t epoch_s);
 
@@ -0,0 +1,22 @@
+// 主机上跑 ebtn 脚本化时间线：5 条 × 4 种调用方式，全部通过返回 0
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "ebtn_timeline.h"
+
+static void host_print(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    vprintf(fmt, ap);
+    va_end(ap);
+}
+
+int main(void)
+{
+    int total;
+    int pass = ebtn_timeline_run_all(host_print, &total);
+
+    printf("timelines: %d/%d passed\n", pass, total);
+    return (pass == total) ? 0 : 1;
+}